@@ -0,0 +1,196 @@
+#include "pch.h"
+#include "Debugger/CheckpointRing.h"
+#include "Shared/Emulator.h"
+#include "Shared/SaveStateManager.h"
+
+CheckpointRing::CheckpointRing(Emulator* emu)
+{
+	_emu = emu;
+}
+
+void CheckpointRing::Clear()
+{
+	_first = 0;
+	_count = 0;
+	_lastStateValid = false;
+}
+
+void CheckpointRing::ReadState(vector<uint8_t>& out)
+{
+	//Reuse the same stream buffer for every checkpoint to avoid reallocating it each time
+	_stateStream.clear();
+	_stateStream.seekp(0, ios::beg);
+	_emu->Serialize(_stateStream, true, 0);
+	uint32_t size = (uint32_t)_stateStream.tellp();
+
+	out.resize(size);
+	_stateStream.seekg(0, ios::beg);
+	_stateStream.read((char*)out.data(), size);
+}
+
+void CheckpointRing::EncodeDelta(Checkpoint& checkpoint, vector<uint8_t>& state)
+{
+	//Store each run of modified bytes as [offset][length][xor data]
+	//Runs separated by less than 8 unchanged bytes are merged, since the run header would cost more than the gap
+	vector<uint8_t>& out = checkpoint.Data;
+	out.clear();
+
+	uint8_t* prev = _lastState.data();
+	uint8_t* curr = state.data();
+	uint32_t size = (uint32_t)state.size();
+	uint32_t i = 0;
+	while(i < size) {
+		if(curr[i] == prev[i]) {
+			i++;
+			continue;
+		}
+
+		uint32_t start = i;
+		uint32_t end = i + 1;
+		for(uint32_t j = i + 1; j < size && j - end < 8; j++) {
+			if(curr[j] != prev[j]) {
+				end = j + 1;
+			}
+		}
+
+		uint32_t length = end - start;
+		size_t pos = out.size();
+		out.resize(pos + 8 + length);
+		memcpy(&out[pos], &start, sizeof(uint32_t));
+		memcpy(&out[pos + 4], &length, sizeof(uint32_t));
+		for(uint32_t k = 0; k < length; k++) {
+			out[pos + 8 + k] = curr[start + k] ^ prev[start + k];
+		}
+		i = end;
+	}
+}
+
+void CheckpointRing::ApplyDelta(Checkpoint& checkpoint, vector<uint8_t>& state)
+{
+	vector<uint8_t>& data = checkpoint.Data;
+	size_t pos = 0;
+	while(pos + 8 <= data.size()) {
+		uint32_t start;
+		uint32_t length;
+		memcpy(&start, &data[pos], sizeof(uint32_t));
+		memcpy(&length, &data[pos + 4], sizeof(uint32_t));
+		pos += 8;
+
+		for(uint32_t k = 0; k < length; k++) {
+			state[start + k] ^= data[pos + k];
+		}
+		pos += length;
+	}
+}
+
+bool CheckpointRing::BuildState(uint32_t index, vector<uint8_t>& state)
+{
+	//Find the closest key frame, then apply each delta up to the requested checkpoint
+	int32_t keyIndex = (int32_t)index;
+	while(keyIndex >= 0 && !GetCheckpoint(keyIndex).IsKeyFrame) {
+		keyIndex--;
+	}
+
+	if(keyIndex < 0) {
+		return false;
+	}
+
+	Checkpoint& keyFrame = GetCheckpoint(keyIndex);
+	state.assign(keyFrame.Data.begin(), keyFrame.Data.end());
+	for(uint32_t i = keyIndex + 1; i <= index; i++) {
+		ApplyDelta(GetCheckpoint(i), state);
+	}
+	return true;
+}
+
+void CheckpointRing::EvictOldest()
+{
+	//Deltas are only valid as long as their key frame exists, drop the whole group
+	do {
+		_first = (_first + 1) % CheckpointRing::Capacity;
+		_count--;
+	} while(_count > 0 && !GetCheckpoint(0).IsKeyFrame);
+}
+
+void CheckpointRing::AddCheckpoint(uint64_t clock)
+{
+	if(_count == CheckpointRing::Capacity) {
+		EvictOldest();
+	}
+
+	ReadState(_restoreBuffer);
+
+	uint32_t sinceKeyFrame = 0;
+	for(int32_t i = (int32_t)_count - 1; i >= 0 && !GetCheckpoint(i).IsKeyFrame; i--) {
+		sinceKeyFrame++;
+	}
+
+	Checkpoint& checkpoint = GetCheckpoint(_count);
+	checkpoint.Clock = clock;
+	checkpoint.StateSize = (uint32_t)_restoreBuffer.size();
+	checkpoint.IsKeyFrame = (
+		_count == 0 ||
+		!_lastStateValid ||
+		_lastState.size() != _restoreBuffer.size() ||
+		sinceKeyFrame + 1 >= CheckpointRing::KeyFrameInterval
+	);
+
+	if(checkpoint.IsKeyFrame) {
+		checkpoint.Data.assign(_restoreBuffer.begin(), _restoreBuffer.end());
+	} else {
+		EncodeDelta(checkpoint, _restoreBuffer);
+	}
+
+	std::swap(_lastState, _restoreBuffer);
+	_lastStateValid = true;
+	_count++;
+}
+
+void CheckpointRing::RemoveAfter(uint64_t clock)
+{
+	uint32_t orgCount = _count;
+	while(_count > 0 && GetCheckpoint(_count - 1).Clock > clock) {
+		_count--;
+	}
+
+	if(_count == 0) {
+		_lastStateValid = false;
+	} else if(_count != orgCount) {
+		//The next delta must be built against the new last checkpoint
+		_lastStateValid = BuildState(_count - 1, _lastState);
+	}
+}
+
+bool CheckpointRing::LoadCheckpoint(uint64_t maxClock)
+{
+	for(int32_t i = (int32_t)_count - 1; i >= 0; i--) {
+		if(GetCheckpoint(i).Clock <= maxClock) {
+			if(!BuildState(i, _restoreBuffer)) {
+				return false;
+			}
+
+			stringstream state;
+			state.write((char*)_restoreBuffer.data(), _restoreBuffer.size());
+			state.seekg(0, ios::beg);
+			return _emu->Deserialize(state, SaveStateManager::FileFormatVersion, true, std::nullopt, false) == DeserializeResult::Success;
+		}
+	}
+	return false;
+}
+
+CheckpointRingStats CheckpointRing::GetStats()
+{
+	uint32_t memoryUsage = (uint32_t)(_lastState.capacity() + _restoreBuffer.capacity());
+	for(uint32_t i = 0; i < CheckpointRing::Capacity; i++) {
+		memoryUsage += (uint32_t)_checkpoints[i].Data.capacity();
+	}
+
+	CheckpointRingStats stats = {};
+	stats.MemoryUsage = memoryUsage;
+	stats.CheckpointCount = _count;
+	if(_count > 0) {
+		stats.OldestClock = GetCheckpoint(0).Clock;
+		stats.NewestClock = GetCheckpoint(_count - 1).Clock;
+	}
+	return stats;
+}
@@ -0,0 +1,63 @@
+#pragma once
+#include "pch.h"
+
+class Emulator;
+
+struct CheckpointRingStats
+{
+	uint32_t MemoryUsage;
+	uint32_t CheckpointCount;
+	uint64_t OldestClock;
+	uint64_t NewestClock;
+};
+
+struct Checkpoint
+{
+	//Either the full uncompressed state (key frames) or a list of [offset, length, xor bytes] runs against the previous checkpoint
+	vector<uint8_t> Data;
+	uint64_t Clock = 0;
+	uint32_t StateSize = 0;
+	bool IsKeyFrame = false;
+};
+
+class CheckpointRing
+{
+public:
+	static constexpr uint32_t Capacity = 64;
+	static constexpr uint32_t KeyFrameInterval = 16;
+
+private:
+	Emulator* _emu = nullptr;
+
+	Checkpoint _checkpoints[CheckpointRing::Capacity] = {};
+	uint32_t _first = 0;
+	uint32_t _count = 0;
+
+	//Raw state of the most recent checkpoint, used to build the next delta
+	vector<uint8_t> _lastState;
+	bool _lastStateValid = false;
+
+	vector<uint8_t> _restoreBuffer;
+	stringstream _stateStream;
+
+	Checkpoint& GetCheckpoint(uint32_t index) { return _checkpoints[(_first + index) % CheckpointRing::Capacity]; }
+
+	void ReadState(vector<uint8_t>& out);
+	void EncodeDelta(Checkpoint& checkpoint, vector<uint8_t>& state);
+	void ApplyDelta(Checkpoint& checkpoint, vector<uint8_t>& state);
+	bool BuildState(uint32_t index, vector<uint8_t>& state);
+	void EvictOldest();
+
+public:
+	CheckpointRing(Emulator* emu);
+
+	void Clear();
+	void AddCheckpoint(uint64_t clock);
+	void RemoveAfter(uint64_t clock);
+	bool LoadCheckpoint(uint64_t maxClock);
+
+	uint64_t GetNewestClock() { return _count ? GetCheckpoint(_count - 1).Clock : 0; }
+	bool IsEmpty() { return _count == 0; }
+
+	CheckpointRingStats GetStats();
+};
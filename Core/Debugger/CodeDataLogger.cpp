@@ -16,6 +16,8 @@ CodeDataLogger::CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t
 	_memSize = memSize;
 	_romCrc32 = romCrc32;
 	_cdlData = new uint8_t[memSize];
+	_pageCount = (memSize >> CodeDataLogger::PageShift) + 1;
+	_dirtyPages.reset(new atomic<uint8_t>[_pageCount]());
 	Reset();
 
 	debugger->GetCdlManager()->RegisterCdl(memType, this);
@@ -29,6 +31,31 @@ CodeDataLogger::~CodeDataLogger()
 void CodeDataLogger::Reset()
 {
 	memset(_cdlData, 0, _memSize);
+	MarkAllDirty();
+}
+
+void CodeDataLogger::MarkAllDirty()
+{
+	for(uint32_t i = 0; i < _pageCount; i++) {
+		_dirtyPages[i].store(true, std::memory_order_relaxed);
+	}
+	_hasChanges.store(true, std::memory_order_release);
+}
+
+void CodeDataLogger::ConsumeChanges(vector<uint32_t>& pageStamps, uint32_t stamp)
+{
+	//Clear the global flag before the pages - a page marked dirty after this point will
+	//set it again, and will be picked up by the next call if it's missed by this one
+	if(!_hasChanges.exchange(false, std::memory_order_acquire)) {
+		return;
+	}
+
+	size_t count = std::min(pageStamps.size(), (size_t)_pageCount);
+	for(size_t i = 0; i < count; i++) {
+		if(_dirtyPages[i].load(std::memory_order_relaxed) && _dirtyPages[i].exchange(false, std::memory_order_relaxed)) {
+			pageStamps[i] = stamp;
+		}
+	}
 }
 
 uint8_t* CodeDataLogger::GetRawData()
@@ -145,6 +172,7 @@ void CodeDataLogger::SetCdlData(uint8_t *cdlData, uint32_t length)
 {
 	if(length <= _memSize) {
 		memcpy(_cdlData, cdlData, length);
+		MarkAllDirty();
 	}
 }
 
@@ -179,6 +207,7 @@ void CodeDataLogger::MarkBytesAs(uint32_t start, uint32_t end, uint8_t flags)
 	for(uint32_t i = start; i <= end; i++) {
 		_cdlData[i] = (_cdlData[i] & 0xFC) | (int)flags;
 	}
+	MarkAllDirty();
 }
 
 void CodeDataLogger::StripData(uint8_t* romBuffer, CdlStripOption flag)
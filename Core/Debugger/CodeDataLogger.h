@@ -15,11 +15,32 @@ protected:
 	MemoryType _memType = {};
 	uint32_t _memSize = 0;
 	uint32_t _romCrc32 = 0;
+
+	//1 byte per page, set when a byte's flags change (consumed by the disassembler to refresh its cached banks)
+	//Written by the emulation thread and cleared by the debugger's refresh thread, so both need to be atomic
+	unique_ptr<atomic<uint8_t>[]> _dirtyPages;
+	uint32_t _pageCount = 0;
+	atomic<bool> _hasChanges;
+
+	__forceinline void UpdateFlags(int32_t absoluteAddr, uint8_t flags)
+	{
+		uint8_t prevFlags = _cdlData[absoluteAddr];
+		if((prevFlags | flags) != prevFlags) {
+			_cdlData[absoluteAddr] = prevFlags | flags;
+			_dirtyPages[absoluteAddr >> CodeDataLogger::PageShift].store(true, std::memory_order_relaxed);
+			//Release ensures the page flag is visible to ConsumeChanges once it sees _hasChanges
+			_hasChanges.store(true, std::memory_order_release);
+		}
+	}
+
+	void MarkAllDirty();
 	
 	virtual void InternalLoadCdlFile(uint8_t* cdlData, uint32_t cdlSize) {}
 	virtual void InternalSaveCdlFile(ofstream& cdlFile) {}
 
 public:
+	static constexpr int PageShift = 8;
+
 	CodeDataLogger(Debugger* debugger, MemoryType memType, uint32_t memSize, CpuType cpuType, uint32_t romCrc32);
 	virtual ~CodeDataLogger();
 
@@ -36,17 +57,17 @@ public:
 	void SetCode(int32_t absoluteAddr)
 	{
 		for(int i = 0; i < accessWidth; i++) {
-			_cdlData[absoluteAddr+i] |= CdlFlags::Code | flags;
+			UpdateFlags(absoluteAddr+i, CdlFlags::Code | flags);
 		}
 	}
 
 	template<uint8_t accessWidth = 1>
 	void SetCode(int32_t absoluteAddr, uint8_t flags)
 	{
-		_cdlData[absoluteAddr] |= CdlFlags::Code | flags; //only sets extra flags on first byte
+		UpdateFlags(absoluteAddr, CdlFlags::Code | flags); //only sets extra flags on first byte
 		if constexpr(accessWidth > 1) {
 			for(int i = 1; i < accessWidth; i++) {
-				_cdlData[absoluteAddr+i] |= CdlFlags::Code;
+				UpdateFlags(absoluteAddr+i, CdlFlags::Code);
 			}
 		}
 	}
@@ -55,7 +76,7 @@ public:
 	void SetData(int32_t absoluteAddr)
 	{
 		for(int i = 0; i < accessWidth; i++) {
-			_cdlData[absoluteAddr+i] |= CdlFlags::Data | flags;
+			UpdateFlags(absoluteAddr+i, CdlFlags::Data | flags);
 		}
 	}
 
@@ -73,6 +94,7 @@ public:
 	uint32_t GetFunctions(uint32_t functions[], uint32_t maxSize);
 
 	void MarkBytesAs(uint32_t start, uint32_t end, uint8_t flags);
+	void ConsumeChanges(vector<uint32_t>& pageStamps, uint32_t stamp);
 	virtual void StripData(uint8_t* romBuffer, CdlStripOption flag);
 
 	virtual void RebuildPrgCache(Disassembler* dis);
@@ -111,7 +111,7 @@ struct DisassemblyResult
 		CommentLine = byteCount;
 	}
 
-	uint8_t GetByteCount()
+	uint8_t GetByteCount() const
 	{
 		return (uint8_t)CommentLine;
 	}
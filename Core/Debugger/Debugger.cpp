@@ -3,6 +3,7 @@
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/MemoryDumper.h"
+#include "Debugger/MemorySearch.h"
 #include "Debugger/MemoryAccessCounter.h"
 #include "Debugger/CodeDataLogger.h"
 #include "Debugger/Disassembler.h"
@@ -79,6 +80,7 @@ Debugger::Debugger(Emulator* emu, IConsole* console)
 
 	_labelManager.reset(new LabelManager(this));
 	_memoryDumper.reset(new MemoryDumper(this));
+	_memorySearch.reset(new MemorySearch(_memoryDumper.get()));
 	_disassembler.reset(new Disassembler(console, this));
 	_disassemblySearch.reset(new DisassemblySearch(_disassembler.get(), _labelManager.get()));
 	_memoryAccessCounter.reset(new MemoryAccessCounter(this));
@@ -138,6 +140,9 @@ Debugger::Debugger(Emulator* emu, IConsole* console)
 
 Debugger::~Debugger()
 {
+	//Stop the background disassembly/search threads before the CPU debuggers and their CDL data are released
+	_disassemblySearch->StopWorkers();
+	_disassembler->StopRefreshThread();
 	Release();
 }
 
@@ -225,6 +230,10 @@ void Debugger::ProcessInstruction()
 		return;
 	}
 
+	if(type == _mainCpuType) {
+		debugger->ProcessStepBackCheckpoint();
+	}
+
 	debugger->IgnoreBreakpoints = false;
 	debugger->AllowChangeProgramCounter = true;
 
@@ -632,6 +641,8 @@ void Debugger::ProcessEvent(EventType type, std::optional<CpuType> cpuTypeOpt)
 				if(callstackManager) {
 					callstackManager->Clear();
 				}
+
+				_debuggers[(int)cpuType].Debugger->ResetStepBackCheckpoints();
 			}
 			break;
 	}
@@ -1199,6 +1210,15 @@ BaseEventManager* Debugger::GetEventManager(CpuType cpuType)
 	return nullptr;
 }
 
+void Debugger::GetStepBackCheckpointStats(CpuType cpuType, CheckpointRingStats& stats)
+{
+	if(_debuggers[(int)cpuType].Debugger) {
+		stats = _debuggers[(int)cpuType].Debugger->GetStepBackCheckpointStats();
+	} else {
+		stats = {};
+	}
+}
+
 CallstackManager* Debugger::GetCallstackManager(CpuType cpuType)
 {
 	if(_debuggers[(int)cpuType].Debugger) {
@@ -19,6 +19,7 @@ class EmuSettings;
 
 class ExpressionEvaluator;
 class MemoryDumper;
+class MemorySearch;
 class MemoryAccessCounter;
 class Disassembler;
 class DisassemblySearch;
@@ -39,6 +40,7 @@ class FrozenAddressManager;
 
 struct TraceRow;
 struct BaseState;
+struct CheckpointRingStats;
 
 enum class EventType;
 enum class MemoryOperationType;
@@ -66,6 +68,7 @@ private:
 
 	unique_ptr<ScriptManager> _scriptManager;
 	unique_ptr<MemoryDumper> _memoryDumper;
+	unique_ptr<MemorySearch> _memorySearch;
 	unique_ptr<MemoryAccessCounter> _memoryAccessCounter;
 	unique_ptr<CodeDataLogger> _codeDataLogger;
 	unique_ptr<Disassembler> _disassembler;
@@ -180,12 +183,15 @@ public:
 
 	void ClearExecutionTrace();
 	uint32_t GetExecutionTrace(TraceRow output[], uint32_t startOffset, uint32_t maxLineCount);
+
+	void GetStepBackCheckpointStats(CpuType cpuType, CheckpointRingStats& stats);
 	
 	CpuType GetMainCpuType() { return _mainCpuType; }
 	IDebugger* GetMainDebugger();
 
 	TraceLogFileSaver* GetTraceLogFileSaver() { return _traceLogSaver.get(); }
 	MemoryDumper* GetMemoryDumper() { return _memoryDumper.get(); }
+	MemorySearch* GetMemorySearch() { return _memorySearch.get(); }
 	MemoryAccessCounter* GetMemoryAccessCounter() { return _memoryAccessCounter.get(); }
 	Disassembler* GetDisassembler() { return _disassembler.get(); }
 	DisassemblySearch* GetDisassemblySearch() { return _disassemblySearch.get(); }
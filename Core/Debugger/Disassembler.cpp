@@ -34,16 +34,33 @@ Disassembler::Disassembler(IConsole* console, Debugger* debugger)
 	_console = console;
 	_settings = debugger->GetEmulator()->GetSettings();
 	_memoryDumper = _debugger->GetMemoryDumper();
+	_changeStamp = 1;
+	_stopFlag = false;
 
 	for(int i = (int)MemoryType::SnesPrgRom; i < DebugUtilities::GetMemoryTypeCount(); i++) {
 		InitSource((MemoryType)i);
 	}
 }
 
+Disassembler::~Disassembler()
+{
+	StopRefreshThread();
+}
+
+void Disassembler::StopRefreshThread()
+{
+	if(_refreshThread) {
+		_stopFlag = true;
+		_refreshSignal.Signal();
+		_refreshThread->join();
+		_refreshThread.reset();
+	}
+}
+
 void Disassembler::InitSource(MemoryType type)
 {
 	uint32_t size = _memoryDumper->GetMemorySize(type);
-	_sources[(int)type] = { vector<DisassemblyInfo>(size), size };
+	_sources[(int)type] = { vector<DisassemblyInfo>(size), vector<uint32_t>((size >> CodeDataLogger::PageShift) + 1), size };
 }
 
 DisassemblerSource& Disassembler::GetSource(MemoryType type)
@@ -51,6 +68,15 @@ DisassemblerSource& Disassembler::GetSource(MemoryType type)
 	return _sources[(int)type];
 }
 
+void Disassembler::MarkChanged(DisassemblerSource& src, int32_t start, int32_t end)
+{
+	uint32_t stamp = _changeStamp;
+	int32_t lastPage = std::min(end >> CodeDataLogger::PageShift, (int32_t)src.PageStamps.size() - 1);
+	for(int32_t page = start >> CodeDataLogger::PageShift; page <= lastPage; page++) {
+		src.PageStamps[page] = stamp;
+	}
+}
+
 uint32_t Disassembler::BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuType type)
 {
 	DisassemblerSource& src = GetSource(addrInfo.Type);
@@ -66,6 +92,7 @@ uint32_t Disassembler::BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuTy
 				//(can happen when resizing an instruction after X/M updates)
 				src.Cache[address + i] = DisassemblyInfo();
 			}
+			MarkChanged(src, address, address + disInfo.GetOpSize() - 1);
 			returnSize += disInfo.GetOpSize();
 		} else {
 			returnSize += disInfo.GetOpSize();
@@ -86,6 +113,9 @@ uint32_t Disassembler::BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuTy
 
 void Disassembler::ResetPrgCache()
 {
+	std::unique_lock<std::shared_mutex> buildLock(_buildLock);
+	auto lock = _snapshotLock.AcquireSafe();
+
 	InitSource(MemoryType::SnesPrgRom);
 	InitSource(MemoryType::GbPrgRom);
 	InitSource(MemoryType::NesPrgRom);
@@ -93,6 +123,7 @@ void Disassembler::ResetPrgCache()
 	InitSource(MemoryType::SmsPrgRom);
 	InitSource(MemoryType::GbaPrgRom);
 	InitSource(MemoryType::WsPrgRom);
+	_resetCount++;
 }
 
 void Disassembler::InvalidateCache(AddressInfo addrInfo, CpuType type)
@@ -104,18 +135,217 @@ void Disassembler::InvalidateCache(AddressInfo addrInfo, CpuType type)
 				src.Cache[addrInfo.Address - i].Reset();
 			}
 		}
+		MarkChanged(src, std::max(0, addrInfo.Address - 3), addrInfo.Address);
+	}
+}
+
+void Disassembler::ConsumeCdlChanges()
+{
+	CdlManager* cdlManager = _debugger->GetCdlManager();
+	uint32_t stamp = _changeStamp;
+	for(int i = 0; i < DebugUtilities::GetMemoryTypeCount(); i++) {
+		CodeDataLogger* cdl = cdlManager->GetCodeDataLogger((MemoryType)i);
+		if(cdl) {
+			cdl->ConsumeChanges(_sources[i].PageStamps, stamp);
+		}
+	}
+}
+
+uint64_t Disassembler::GetConfigKey()
+{
+	DebugConfig& cfg = _settings->GetDebugConfig();
+	uint64_t key = (
+		(cfg.DisassembleUnidentifiedData ? 0x01 : 0) |
+		(cfg.DisassembleVerifiedData ? 0x02 : 0) |
+		(cfg.ShowUnidentifiedData ? 0x04 : 0) |
+		(cfg.ShowVerifiedData ? 0x08 : 0) |
+		(cfg.ShowJumpLabels ? 0x10 : 0)
+	);
+
+	if(cfg.DisassembleUnidentifiedData || cfg.DisassembleVerifiedData) {
+		//CPU flags are only used when disassembling bytes that weren't executed yet
+		for(int i = 0; i < 4; i++) {
+			key |= (uint64_t)_debugger->GetMainDebugger()->GetCpuFlags(i) << (8 + i * 8);
+		}
+	}
+	return key;
+}
+
+bool Disassembler::IsSnapshotValid(DisassemblySnapshot& snapshot, CpuType cpuType, uint16_t bank)
+{
+	if(snapshot.Volatile || snapshot.ResetCount != _resetCount || snapshot.LabelVersion != _labelManager->GetVersion() || snapshot.ConfigKey != GetConfigKey()) {
+		return false;
+	}
+
+	AddressInfo relAddress = {};
+	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
+	int32_t bankStart = bank << 16;
+	for(size_t i = 0; i < snapshot.PageMappings.size(); i++) {
+		//The bank needs to be rebuilt if its mappings changed, or if any of the pages it maps to were modified
+		relAddress.Address = bankStart + ((int32_t)i << CodeDataLogger::PageShift);
+		AddressInfo addrInfo = _console->GetAbsoluteAddress(relAddress);
+		AddressInfo& prevAddrInfo = snapshot.PageMappings[i];
+		if(addrInfo.Address != prevAddrInfo.Address || addrInfo.Type != prevAddrInfo.Type) {
+			return false;
+		}
+
+		if(addrInfo.Address >= 0 && addrInfo.Type != MemoryType::SnesRegister) {
+			DisassemblerSource& src = GetSource(addrInfo.Type);
+			uint32_t firstPage = addrInfo.Address >> CodeDataLogger::PageShift;
+			uint32_t lastPage = std::min<uint32_t>((addrInfo.Address + (1 << CodeDataLogger::PageShift) - 1) >> CodeDataLogger::PageShift, (uint32_t)src.PageStamps.size() - 1);
+			for(uint32_t page = firstPage; page <= lastPage; page++) {
+				if(src.PageStamps[page] >= snapshot.Stamp) {
+					return false;
+				}
+			}
+		}
 	}
+
+	return true;
 }
 
-vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t bank)
+shared_ptr<DisassemblySnapshot> Disassembler::FindSnapshot(CpuType cpuType, uint16_t bank, bool& isValid, shared_ptr<DisassemblySnapshot> prevSnapshot)
+{
+	auto lock = _snapshotLock.AcquireSafe();
+	ConsumeCdlChanges();
+
+	isValid = false;
+	auto result = _snapshots.find(((uint32_t)cpuType << 16) | bank);
+	if(result == _snapshots.end()) {
+		if(prevSnapshot && IsSnapshotValid(*prevSnapshot, cpuType, bank)) {
+			//The caller kept a snapshot that was evicted from the cache, but is still valid - reuse it
+			StoreSnapshot(cpuType, bank, prevSnapshot);
+			isValid = true;
+			return prevSnapshot;
+		}
+		return nullptr;
+	}
+
+	result->second.LastUsed = ++_snapshotCounter;
+	isValid = IsSnapshotValid(*result->second.Snapshot, cpuType, bank);
+	return result->second.Snapshot;
+}
+
+shared_ptr<DisassemblySnapshot> Disassembler::BuildSnapshot(CpuType cpuType, uint16_t bank)
+{
+	std::shared_lock<std::shared_mutex> buildLock(_buildLock);
+
+	shared_ptr<DisassemblySnapshot> snapshot = std::make_shared<DisassemblySnapshot>();
+	{
+		auto lock = _snapshotLock.AcquireSafe();
+		ConsumeCdlChanges();
+
+		//Any change made from this point on will have a stamp >= to the snapshot's stamp and invalidate it
+		snapshot->Stamp = ++_changeStamp;
+	}
+
+	snapshot->ResetCount = _resetCount;
+	snapshot->LabelVersion = _labelManager->GetVersion();
+	snapshot->ConfigKey = GetConfigKey();
+
+	AddressInfo relAddress = {};
+	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
+	if(bank <= GetMaxBank(cpuType)) {
+		int32_t bankStart = bank << 16;
+		int32_t bankSize = std::min<int32_t>(0x10000, (int32_t)_memoryDumper->GetMemorySize(relAddress.Type) - bankStart);
+		for(int32_t i = 0; i < bankSize; i += (1 << CodeDataLogger::PageShift)) {
+			relAddress.Address = bankStart + i;
+			snapshot->PageMappings.push_back(_console->GetAbsoluteAddress(relAddress));
+		}
+	}
+
+	Disassemble(cpuType, bank, *snapshot);
+
+	auto lock = _snapshotLock.AcquireSafe();
+	StoreSnapshot(cpuType, bank, snapshot);
+	return snapshot;
+}
+
+void Disassembler::StoreSnapshot(CpuType cpuType, uint16_t bank, shared_ptr<DisassemblySnapshot> snapshot)
+{
+	auto lock = _snapshotLock.AcquireSafe();
+	if(_snapshots.size() >= Disassembler::MaxSnapshotCount) {
+		//Evict the least recently used bank
+		auto oldest = _snapshots.begin();
+		for(auto it = _snapshots.begin(); it != _snapshots.end(); it++) {
+			if(it->second.LastUsed < oldest->second.LastUsed) {
+				oldest = it;
+			}
+		}
+		_snapshots.erase(oldest);
+	}
+	_snapshots[((uint32_t)cpuType << 16) | bank] = { snapshot, ++_snapshotCounter };
+}
+
+shared_ptr<DisassemblySnapshot> Disassembler::GetSnapshot(CpuType cpuType, uint16_t bank, shared_ptr<DisassemblySnapshot> prevSnapshot)
+{
+	bool isValid;
+	shared_ptr<DisassemblySnapshot> snapshot = FindSnapshot(cpuType, bank, isValid, prevSnapshot);
+	if(snapshot) {
+		if(isValid) {
+			return snapshot;
+		} else if(!_debugger->IsExecutionStopped()) {
+			//Emulation is running, return the previous snapshot and rebuild the bank in the background
+			//to avoid rebuilding the same bank on the UI thread every time the emulation updates the CDL data
+			QueueRefresh(cpuType, bank);
+			return snapshot;
+		}
+	}
+
+	return BuildSnapshot(cpuType, bank);
+}
+
+void Disassembler::QueueRefresh(CpuType cpuType, uint16_t bank)
+{
+	auto lock = _snapshotLock.AcquireSafe();
+	uint32_t key = ((uint32_t)cpuType << 16) | bank;
+	if(std::find(_pendingBanks.begin(), _pendingBanks.end(), key) == _pendingBanks.end()) {
+		_pendingBanks.push_back(key);
+	}
+
+	if(!_refreshThread) {
+		_stopFlag = false;
+		_refreshThread.reset(new std::thread(&Disassembler::RefreshThread, this));
+	}
+	_refreshSignal.Signal();
+}
+
+void Disassembler::RefreshThread()
+{
+	while(!_stopFlag) {
+		_refreshSignal.Wait();
+
+		while(!_stopFlag) {
+			uint32_t key;
+			{
+				auto lock = _snapshotLock.AcquireSafe();
+				if(_pendingBanks.empty()) {
+					break;
+				}
+				key = _pendingBanks.front();
+				_pendingBanks.erase(_pendingBanks.begin());
+			}
+
+			CpuType cpuType = (CpuType)(key >> 16);
+			uint16_t bank = (uint16_t)key;
+			bool isValid;
+			FindSnapshot(cpuType, bank, isValid);
+			if(!isValid) {
+				BuildSnapshot(cpuType, bank);
+			}
+		}
+	}
+}
+
+void Disassembler::Disassemble(CpuType cpuType, uint16_t bank, DisassemblySnapshot& snapshot)
 {
 	if(!_debugger->HasCpuType(cpuType)) {
-		return {};
+		return;
 	}
 
 	constexpr int bytesPerRow = 8;
 
-	vector<DisassemblyResult> results;
+	vector<DisassemblyResult>& results = snapshot.Rows;
 	results.reserve(20000);
 
 	DebugConfig& cfg = _settings->GetDebugConfig();
@@ -136,7 +366,7 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 	relAddress.Type = DebugUtilities::GetCpuMemoryType(cpuType);
 
 	if(bank > GetMaxBank(cpuType)) {
-		return results;
+		return;
 	}
 
 	int32_t bankStart = bank << 16;
@@ -205,6 +435,9 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 		} else if((isData && disData) || (!isData && !isCode && disUnident)) {
 			disassemblyInfo.Initialize(i, cpuFlags[addrInfo.Address & 0x03], cpuType, relAddress.Type, _memoryDumper);
 			opSize = disassemblyInfo.GetOpSize();
+			if(!DebugUtilities::IsRom(addrInfo.Type)) {
+				snapshot.Volatile = true;
+			}
 		}
 
 		if(opSize > 0) {
@@ -306,11 +539,9 @@ vector<DisassemblyResult> Disassembler::Disassemble(CpuType cpuType, uint16_t ba
 	if(inUnmappedBlock) {
 		pushUnmappedBlock();
 	}
-
-	return results;
 }
 
-void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType memType, CodeLineData& data)
+void Disassembler::GetLineData(const DisassemblyResult& row, CpuType type, MemoryType memType, CodeLineData& data)
 {
 	data.Address = row.CpuAddress;
 	data.AbsoluteAddress = row.Address;
@@ -650,7 +881,7 @@ void Disassembler::GetLineData(DisassemblyResult& row, CpuType type, MemoryType
 	}
 }
 
-int32_t Disassembler::GetMatchingRow(vector<DisassemblyResult>& rows, uint32_t address, bool returnFirstRow)
+int32_t Disassembler::GetMatchingRow(const vector<DisassemblyResult>& rows, uint32_t address, bool returnFirstRow)
 {
 	int32_t i;
 	for(i = 0; i < (int32_t)rows.size(); i++) {
@@ -673,12 +904,11 @@ int32_t Disassembler::GetMatchingRow(vector<DisassemblyResult>& rows, uint32_t a
 uint32_t Disassembler::GetDisassemblyOutput(CpuType type, uint32_t address, CodeLineData output[], uint32_t rowCount)
 {
 	uint16_t bank = address >> 16;
-	Timer timer;
-	vector<DisassemblyResult> rows = Disassemble(type, bank);
+	shared_ptr<DisassemblySnapshot> snapshot = GetSnapshot(type, bank);
 
-	int32_t i = GetMatchingRow(rows, address, true);
+	int32_t i = GetMatchingRow(snapshot->Rows, address, true);
 
-	if(i >= (int32_t)rows.size()) {
+	if(i >= (int32_t)snapshot->Rows.size()) {
 		return 0;
 	}
 
@@ -687,11 +917,11 @@ uint32_t Disassembler::GetDisassemblyOutput(CpuType type, uint32_t address, Code
 
 	int32_t row;
 	for(row = 0; row < (int32_t)rowCount; row++){
-		if(row + i >= rows.size()) {
+		if(row + i >= snapshot->Rows.size()) {
 			if(bank < maxBank) {
 				bank++;
-				rows = Disassemble(type, bank);
-				if(rows.size() == 0) {
+				snapshot = GetSnapshot(type, bank);
+				if(snapshot->Rows.size() == 0) {
 					break;
 				}
 				i = -row;
@@ -700,7 +930,13 @@ uint32_t Disassembler::GetDisassemblyOutput(CpuType type, uint32_t address, Code
 			}
 		}
 
-		GetLineData(rows[row + i], type, memType, output[row]);
+		GetLineData(snapshot->Rows[row + i], type, memType, output[row]);
+	}
+
+	if(bank < maxBank && (int32_t)snapshot->Rows.size() - (row + i) < (int32_t)rowCount * 4) {
+		//Prepare the next bank in the background when getting close to the end of the current one,
+		//to avoid a delay when scrolling past the end of the current bank
+		QueueRefresh(type, bank + 1);
 	}
 
 	return row;
@@ -716,20 +952,21 @@ uint16_t Disassembler::GetMaxBank(CpuType cpuType)
 int32_t Disassembler::GetDisassemblyRowAddress(CpuType cpuType, uint32_t address, int32_t rowOffset)
 {
 	uint16_t bank = address >> 16;
-	vector<DisassemblyResult> rows = Disassemble(cpuType, bank);
-	int32_t len = (int32_t)rows.size();
+	shared_ptr<DisassemblySnapshot> snapshot = GetSnapshot(cpuType, bank);
+	vector<DisassemblyResult>* rows = &snapshot->Rows;
+	int32_t len = (int32_t)rows->size();
 	if(len == 0) {
 		return address;
 	}
 
 	uint16_t maxBank = GetMaxBank(cpuType);
-	int32_t i = GetMatchingRow(rows, address, false);
+	int32_t i = GetMatchingRow(*rows, address, false);
 
 	if(rowOffset > 0) {
 		while(len > 0) {
 			for(; i < len; i++) {
-				if(rowOffset <= 0 && rows[i].CpuAddress >= 0 && rows[i].CpuAddress != (int32_t)address) {
-					return rows[i].CpuAddress;
+				if(rowOffset <= 0 && (*rows)[i].CpuAddress >= 0 && (*rows)[i].CpuAddress != (int32_t)address) {
+					return (*rows)[i].CpuAddress;
 				}
 				rowOffset--;
 			}
@@ -737,19 +974,20 @@ int32_t Disassembler::GetDisassemblyRowAddress(CpuType cpuType, uint32_t address
 			//End of bank, didn't find an appropriate row to jump to, try the next bank
 			if(bank == maxBank) {
 				//Reached bottom of last bank, return the bottom row
-				return rows[len - 1].CpuAddress >= 0 ? rows[len - 1].CpuAddress : address;
+				return (*rows)[len - 1].CpuAddress >= 0 ? (*rows)[len - 1].CpuAddress : address;
 			}
 
 			bank++;
-			rows = Disassemble(cpuType, bank);
-			len = (int32_t)rows.size();
+			snapshot = GetSnapshot(cpuType, bank);
+			rows = &snapshot->Rows;
+			len = (int32_t)rows->size();
 			i = 0;
 		}
 	} else if(rowOffset < 0) {
 		while(len > 0) {
 			for(; i >= 0; i--) {
-				if(rowOffset >= 0 && rows[i].CpuAddress >= 0 && rows[i].CpuAddress != (int32_t)address) {
-					return rows[i].CpuAddress;
+				if(rowOffset >= 0 && (*rows)[i].CpuAddress >= 0 && (*rows)[i].CpuAddress != (int32_t)address) {
+					return (*rows)[i].CpuAddress;
 				}
 				rowOffset++;
 			}
@@ -757,12 +995,13 @@ int32_t Disassembler::GetDisassemblyRowAddress(CpuType cpuType, uint32_t address
 			//Start of bank, didn't find an appropriate row to jump to, try the previous bank
 			if(bank == 0) {
 				//Reached top of first bank, return the top row
-				return rows[0].CpuAddress >= 0 ? rows[0].CpuAddress : address;
+				return (*rows)[0].CpuAddress >= 0 ? (*rows)[0].CpuAddress : address;
 			}
 
 			bank--;
-			rows = Disassemble(cpuType, bank);
-			len = (int32_t)rows.size();
+			snapshot = GetSnapshot(cpuType, bank);
+			rows = &snapshot->Rows;
+			len = (int32_t)rows->size();
 			i = len - 1;
 		}
 	}
@@ -3,6 +3,10 @@
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
+#include <unordered_map>
+#include <shared_mutex>
 
 class IConsole;
 class Debugger;
@@ -17,9 +21,35 @@ enum class CpuType : uint8_t;
 struct DisassemblerSource
 {
 	vector<DisassemblyInfo> Cache;
+
+	//Stamp of the last change made to each page (disassembly cache or CDL flags)
+	vector<uint32_t> PageStamps;
+
 	uint32_t Size = 0;
 };
 
+struct DisassemblySnapshot
+{
+	vector<DisassemblyResult> Rows;
+
+	//Absolute address mapped to each page of the bank when the snapshot was built
+	vector<AddressInfo> PageMappings;
+
+	uint32_t Stamp = 0;
+	uint32_t ResetCount = 0;
+	uint32_t LabelVersion = 0;
+	uint64_t ConfigKey = 0;
+
+	//Set when unverified code in RAM was disassembled, the result can change at any time and can't be reused
+	bool Volatile = false;
+};
+
+struct DisassemblySnapshotEntry
+{
+	shared_ptr<DisassemblySnapshot> Snapshot;
+	uint32_t LastUsed = 0;
+};
+
 class Disassembler
 {
 private:
@@ -31,18 +61,49 @@ private:
 	LabelManager* _labelManager;
 	MemoryDumper *_memoryDumper;
 
+	static constexpr uint32_t MaxSnapshotCount = 32;
+
 	DisassemblerSource _sources[DebugUtilities::GetMemoryTypeCount()] = {};
+
+	std::atomic<uint32_t> _changeStamp;
+	uint32_t _resetCount = 0;
+
+	//Held in shared mode while building snapshots (multiple banks can be built at once) and in exclusive mode while resetting the sources
+	//_buildLock must always be acquired before _snapshotLock
+	std::shared_mutex _buildLock;
+	SimpleLock _snapshotLock;
+	std::unordered_map<uint32_t, DisassemblySnapshotEntry> _snapshots;
+	uint32_t _snapshotCounter = 0;
+	vector<uint32_t> _pendingBanks;
+
+	unique_ptr<std::thread> _refreshThread;
+	AutoResetEvent _refreshSignal;
+	atomic<bool> _stopFlag;
 	
 	void InitSource(MemoryType type);
 	DisassemblerSource& GetSource(MemoryType type);
+	void MarkChanged(DisassemblerSource& src, int32_t start, int32_t end);
 
-	void GetLineData(DisassemblyResult& result, CpuType type, MemoryType memType, CodeLineData& data);
-	int32_t GetMatchingRow(vector<DisassemblyResult>& rows, uint32_t address, bool returnFirstRow);
-	vector<DisassemblyResult> Disassemble(CpuType cpuType, uint16_t bank);
+	void ConsumeCdlChanges();
+	uint64_t GetConfigKey();
+	bool IsSnapshotValid(DisassemblySnapshot& snapshot, CpuType cpuType, uint16_t bank);
+	shared_ptr<DisassemblySnapshot> FindSnapshot(CpuType cpuType, uint16_t bank, bool& isValid, shared_ptr<DisassemblySnapshot> prevSnapshot = nullptr);
+	shared_ptr<DisassemblySnapshot> BuildSnapshot(CpuType cpuType, uint16_t bank);
+	void StoreSnapshot(CpuType cpuType, uint16_t bank, shared_ptr<DisassemblySnapshot> snapshot);
+	shared_ptr<DisassemblySnapshot> GetSnapshot(CpuType cpuType, uint16_t bank, shared_ptr<DisassemblySnapshot> prevSnapshot = nullptr);
+	void QueueRefresh(CpuType cpuType, uint16_t bank);
+	void RefreshThread();
+
+	void GetLineData(const DisassemblyResult& result, CpuType type, MemoryType memType, CodeLineData& data);
+	int32_t GetMatchingRow(const vector<DisassemblyResult>& rows, uint32_t address, bool returnFirstRow);
+	void Disassemble(CpuType cpuType, uint16_t bank, DisassemblySnapshot& snapshot);
 	uint16_t GetMaxBank(CpuType cpuType);
 	
 public:
 	Disassembler(IConsole* console, Debugger* debugger);
+	~Disassembler();
+
+	void StopRefreshThread();
 
 	uint32_t BuildCache(AddressInfo &addrInfo, uint8_t cpuFlags, CpuType type);
 	void ResetPrgCache();
@@ -2,11 +2,13 @@
 #include "Debugger/Disassembler.h"
 #include "Debugger/DisassemblySearch.h"
 #include "Debugger/LabelManager.h"
+#include "Shared/EmuSettings.h"
 
 DisassemblySearch::DisassemblySearch(Disassembler* disassembler, LabelManager* labelManager)
 {
 	_disassembler = disassembler;
 	_labelManager = labelManager;
+	_cancelledSearchId = 0;
 }
 
 int32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options)
@@ -16,9 +18,338 @@ int32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* search
 	return resultCount > 0 ? results[0].Address : -1;
 }
 
-uint32_t DisassemblySearch::FindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, CodeLineData output[], uint32_t maxResultCount)
+DisassemblySearch::~DisassemblySearch()
 {
-	return SearchDisassembly(cpuType, searchString, 0, options, output, maxResultCount);
+	StopWorkers();
+}
+
+void DisassemblySearch::StopWorkers()
+{
+	{
+		std::unique_lock<std::mutex> lock(_jobLock);
+		_stopWorkers = true;
+		if(_job) {
+			CancelSearch(_job->SearchId);
+			_job.reset();
+		}
+	}
+	_jobSignal.notify_all();
+
+	for(std::thread& worker : _workers) {
+		worker.join();
+	}
+	_workers.clear();
+}
+
+void DisassemblySearch::StartFindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, uint32_t maxResultCount, uint32_t searchId)
+{
+	shared_ptr<DisassemblySearchJob> job = std::make_shared<DisassemblySearchJob>();
+	job->SearchId = searchId;
+	job->Cpu = cpuType;
+	job->Needle = searchString;
+	job->Options = options;
+	job->MaxResultCount = maxResultCount;
+
+	if(options.SearchBackwards || maxResultCount <= 1 || job->Needle.empty()) {
+		//Use the sequential search, the results are available immediately
+		vector<CodeLineData> results(maxResultCount);
+		results.resize(SearchDisassembly(cpuType, searchString, 0, options, results.data(), maxResultCount));
+		job->BankCount = 1;
+		job->NextBank = 1;
+		job->DoneBankCount = 1;
+		job->BankResults.push_back(std::move(results));
+		job->BankDone.push_back(true);
+	} else {
+		//Each bank is searched separately by the workers
+		job->BankCount = _disassembler->GetMaxBank(cpuType) + 1;
+		job->LastBank = job->BankCount - 1;
+		job->BankResults.resize(job->BankCount);
+		job->BankDone.resize(job->BankCount);
+	}
+
+	{
+		std::unique_lock<std::mutex> lock(_jobLock);
+		if(_stopWorkers) {
+			return;
+		}
+
+		//Only the most recent search is kept, any older search still running is cancelled
+		_job = job;
+		CancelSearch(searchId - 1);
+		if(_workers.empty()) {
+			uint32_t workerCount = std::min(std::max(std::thread::hardware_concurrency(), 1u), DisassemblySearch::MaxWorkerCount);
+			for(uint32_t i = 0; i < workerCount; i++) {
+				_workers.emplace_back(&DisassemblySearch::WorkerThread, this);
+			}
+		}
+	}
+	_jobSignal.notify_all();
+}
+
+void DisassemblySearch::WorkerThread()
+{
+	std::unique_lock<std::mutex> lock(_jobLock);
+	while(!_stopWorkers) {
+		shared_ptr<DisassemblySearchJob> job = _job;
+		if(!job || job->NextBank > job->LastBank || IsCancelled(job->SearchId)) {
+			_jobSignal.wait(lock);
+			continue;
+		}
+
+		uint32_t bank = job->NextBank++;
+		job->ActiveWorkers++;
+		lock.unlock();
+
+		vector<CodeLineData> results;
+		SearchBank(job->Cpu, bank, job->Needle, job->Options, bank == 0 && job->Options.SkipFirstLine, job->MaxResultCount, job->SearchId, results);
+
+		lock.lock();
+		job->ActiveWorkers--;
+		if(IsCancelled(job->SearchId) || bank > job->LastBank) {
+			//The bank may have only been partially searched, or its results aren't needed anymore
+			continue;
+		}
+
+		job->BankResults[bank] = std::move(results);
+		job->BankDone[bank] = true;
+
+		//Results are returned in bank order, as soon as all the banks before them have been searched
+		//Once the first banks contain enough results, the banks that follow don't need to be searched
+		while(job->DoneBankCount <= job->LastBank && job->BankDone[job->DoneBankCount]) {
+			job->ResultCount += (uint32_t)job->BankResults[job->DoneBankCount].size();
+			job->DoneBankCount++;
+			if(job->ResultCount >= job->MaxResultCount) {
+				job->LastBank = job->DoneBankCount - 1;
+			}
+		}
+	}
+}
+
+bool DisassemblySearch::IsJobFinished(DisassemblySearchJob& job)
+{
+	return job.ActiveWorkers == 0 && (job.NextBank > job.LastBank || IsCancelled(job.SearchId));
+}
+
+bool DisassemblySearch::GetFindOccurrencesResults(uint32_t searchId, uint32_t startIndex, CodeLineData output[], uint32_t maxResultCount, uint32_t& resultCount)
+{
+	//Returns the results found so far, starting at the given index, and whether the search is still running
+	resultCount = 0;
+
+	std::unique_lock<std::mutex> lock(_jobLock);
+	shared_ptr<DisassemblySearchJob> job = _job;
+	if(!job || job->SearchId != searchId) {
+		return false;
+	}
+
+	uint32_t index = 0;
+	for(uint32_t i = 0; i < job->DoneBankCount && resultCount < maxResultCount; i++) {
+		for(CodeLineData& result : job->BankResults[i]) {
+			if(index >= job->MaxResultCount || resultCount >= maxResultCount) {
+				break;
+			}
+			if(index >= startIndex) {
+				output[resultCount++] = result;
+			}
+			index++;
+		}
+	}
+
+	return !IsJobFinished(*job);
+}
+
+void DisassemblySearch::CancelSearch(uint32_t searchId)
+{
+	//Cancels the given search, even if it hasn't started yet, along with any older search still running
+	uint32_t cancelledId = _cancelledSearchId;
+	while((int32_t)(searchId - cancelledId) > 0) {
+		if(_cancelledSearchId.compare_exchange_weak(cancelledId, searchId)) {
+			break;
+		}
+	}
+}
+
+bool DisassemblySearch::IsCancelled(uint32_t searchId)
+{
+	return (int32_t)(_cancelledSearchId - searchId) >= 0;
+}
+
+uint32_t DisassemblySearch::GetDisplayKey()
+{
+	//Display options that change the text of the disassembly
+	DebugConfig& cfg = _disassembler->_settings->GetDebugConfig();
+	return (
+		(cfg.UseLowerCaseDisassembly ? 0x01 : 0) |
+		(cfg.ShowMemoryValues ? 0x02 : 0) |
+		(cfg.SnesUseAltSpcOpNames ? 0x04 : 0) |
+		((uint32_t)cfg.GbaDisMode << 8)
+	);
+}
+
+shared_ptr<DisassemblySearchIndex> DisassemblySearch::GetIndex(CpuType cpuType, uint16_t bank)
+{
+	uint32_t key = ((uint32_t)cpuType << 16) | bank;
+	shared_ptr<DisassemblySearchIndex> index;
+	{
+		auto lock = _indexLock.AcquireSafe();
+		auto result = _indexes.find(key);
+		if(result != _indexes.end()) {
+			result->second.LastUsed = ++_indexCounter;
+			index = result->second.Index;
+		}
+	}
+
+	shared_ptr<DisassemblySnapshot> snapshot = _disassembler->GetSnapshot(cpuType, bank, index ? index->Snapshot : nullptr);
+	if(index && index->Snapshot == snapshot && index->DisplayKey == GetDisplayKey()) {
+		return index;
+	}
+
+	index = BuildIndex(cpuType, snapshot);
+
+	auto lock = _indexLock.AcquireSafe();
+	if(_indexes.find(key) == _indexes.end() && _indexes.size() >= DisassemblySearch::MaxIndexCount) {
+		//Evict the least recently used bank
+		auto oldest = _indexes.begin();
+		for(auto it = _indexes.begin(); it != _indexes.end(); it++) {
+			if(it->second.LastUsed < oldest->second.LastUsed) {
+				oldest = it;
+			}
+		}
+		_indexes.erase(oldest);
+	}
+	_indexes[key] = { index, ++_indexCounter };
+	return index;
+}
+
+shared_ptr<DisassemblySearchIndex> DisassemblySearch::BuildIndex(CpuType cpuType, shared_ptr<DisassemblySnapshot> snapshot)
+{
+	shared_ptr<DisassemblySearchIndex> index = std::make_shared<DisassemblySearchIndex>();
+	index->Snapshot = snapshot;
+	index->DisplayKey = GetDisplayKey();
+	index->CharPairs.resize(0x10000 / 64);
+
+	MemoryType memType = DebugUtilities::GetCpuMemoryType(cpuType);
+	vector<DisassemblyResult>& rows = snapshot->Rows;
+	index->RowOffsets.reserve(rows.size());
+
+	CodeLineData lineData = {};
+	string txt;
+	for(DisassemblyResult& row : rows) {
+		if(row.CpuAddress < 0) {
+			index->RowOffsets.push_back(DisassemblySearchIndex::SkipRow);
+			continue;
+		}
+
+		_disassembler->GetLineData(row, cpuType, memType, lineData);
+
+		if((row.Address.Address >= 0 && !DebugUtilities::IsRom(row.Address.Type)) || lineData.EffectiveAddress.ShowAddress) {
+			//Content depends on RAM or on the CPU's state, it can't be indexed
+			index->RowOffsets.push_back(DisassemblySearchIndex::DynamicRow);
+			index->HasDynamicRows = true;
+			continue;
+		}
+
+		index->RowOffsets.push_back((uint32_t)index->Text.size());
+		index->Text.append(lineData.Text, strnlen(lineData.Text, 1000));
+		index->Text.push_back(0);
+		index->Text.append(lineData.Comment, strnlen(lineData.Comment, 1000));
+		index->Text.push_back(0);
+		GetEffectiveAddressText(lineData, txt);
+		index->Text.append(txt);
+		index->Text.push_back(0);
+	}
+
+	for(size_t i = 1; i < index->Text.size(); i++) {
+		uint16_t pair = ((uint8_t)tolower(index->Text[i - 1]) << 8) | (uint8_t)tolower(index->Text[i]);
+		index->CharPairs[pair >> 6] |= 1ULL << (pair & 0x3F);
+	}
+
+	return index;
+}
+
+bool DisassemblySearchIndex::MayContain(const string& needle)
+{
+	for(size_t i = 1; i < needle.size(); i++) {
+		uint16_t pair = ((uint8_t)tolower(needle[i - 1]) << 8) | (uint8_t)tolower(needle[i]);
+		if(!(CharPairs[pair >> 6] & (1ULL << (pair & 0x3F)))) {
+			return false;
+		}
+	}
+	return true;
+}
+
+void DisassemblySearch::SearchBank(CpuType cpuType, uint16_t bank, string& needle, DisassemblySearchOptions& options, bool skipFirstRow, uint32_t maxResultCount, uint32_t searchId, vector<CodeLineData>& results)
+{
+	shared_ptr<DisassemblySearchIndex> index = GetIndex(cpuType, bank);
+	bool checkIndexedRows = index->MayContain(needle);
+	if(!checkIndexedRows && !index->HasDynamicRows) {
+		return;
+	}
+
+	MemoryType memType = DebugUtilities::GetCpuMemoryType(cpuType);
+	vector<DisassemblyResult>& rows = index->Snapshot->Rows;
+	const char* text = index->Text.c_str();
+	int32_t textSize = (int32_t)index->Text.size();
+
+	CodeLineData lineData = {};
+	string txt;
+	for(size_t i = skipFirstRow ? 1 : 0; i < rows.size() && !IsCancelled(searchId); i++) {
+		uint32_t offset = index->RowOffsets[i];
+		if(offset == DisassemblySearchIndex::SkipRow) {
+			continue;
+		}
+
+		if(offset == DisassemblySearchIndex::DynamicRow) {
+			_disassembler->GetLineData(rows[i], cpuType, memType, lineData);
+			if(!MatchesLine(lineData, needle, options, txt)) {
+				continue;
+			}
+		} else {
+			if(!checkIndexedRows) {
+				continue;
+			}
+
+			//Text, comment and effective address are stored one after the other
+			const char* lineText = text + offset;
+			const char* comment = lineText + strlen(lineText) + 1;
+			const char* effectiveAddress = comment + strlen(comment) + 1;
+			if(
+				!TextContains(needle, lineText, textSize - (int32_t)(lineText - text), options) &&
+				!TextContains(needle, comment, textSize - (int32_t)(comment - text), options) &&
+				!TextContains(needle, effectiveAddress, textSize - (int32_t)(effectiveAddress - text), options)
+			) {
+				continue;
+			}
+			_disassembler->GetLineData(rows[i], cpuType, memType, lineData);
+		}
+
+		results.push_back(lineData);
+		if(results.size() >= maxResultCount) {
+			return;
+		}
+	}
+}
+
+bool DisassemblySearch::MatchesLine(CodeLineData& lineData, string& needle, DisassemblySearchOptions& options, string& txt)
+{
+	if(TextContains(needle, lineData.Text, 1000, options) || TextContains(needle, lineData.Comment, 1000, options)) {
+		return true;
+	}
+
+	GetEffectiveAddressText(lineData, txt);
+	return !txt.empty() && TextContains(needle, txt.c_str(), (int)txt.size(), options);
+}
+
+void DisassemblySearch::GetEffectiveAddressText(CodeLineData& lineData, string& out)
+{
+	out.clear();
+	if(lineData.EffectiveAddress.ShowAddress && lineData.EffectiveAddress.Address >= 0) {
+		out = _labelManager->GetLabel({ (int32_t)lineData.EffectiveAddress.Address, lineData.EffectiveAddress.Type });
+		if(out.empty()) {
+			out = "[$" + DebugUtilities::AddressToHex(lineData.LineCpuType, lineData.EffectiveAddress.Address) + "]";
+		} else {
+			out = "[" + out + "]";
+		}
+	}
 }
 
 uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options, CodeLineData searchResults[], uint32_t maxResultCount)
@@ -27,23 +358,24 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 	uint16_t bank = startAddress >> 16;
 	uint16_t maxBank = _disassembler->GetMaxBank(cpuType);
 
-	vector<DisassemblyResult> rows = _disassembler->Disassemble(cpuType, bank);
-	if(rows.empty()) {
-		return -1;
+	shared_ptr<DisassemblySnapshot> snapshot = _disassembler->GetSnapshot(cpuType, bank);
+	vector<DisassemblyResult>* rows = &snapshot->Rows;
+	if(rows->empty()) {
+		return 0;
 	}
 	int step = options.SearchBackwards ? -1 : 1;
 
 	string searchStr = searchString;
 
-	int32_t startRow = _disassembler->GetMatchingRow(rows, startAddress, options.SearchBackwards);
+	int32_t startRow = _disassembler->GetMatchingRow(*rows, startAddress, options.SearchBackwards);
 	if(options.SearchBackwards) {
 		startRow--;
 	} else if(options.SkipFirstLine) {
 		startRow++;
 	}
 
-	if(startRow >= 0 && startRow < rows.size()) {
-		startAddress = rows[startRow].CpuAddress;
+	if(startRow >= 0 && startRow < rows->size()) {
+		startAddress = (*rows)[startRow].CpuAddress;
 	}
 
 	uint32_t resultCount = 0;
@@ -56,14 +388,15 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 	string txt;
 
 	do {
-		for(int i = startRow; i >= 0 && i < rows.size(); i += step) {
-			if(rows[i].CpuAddress < 0) {
+		for(int i = startRow; i >= 0 && i < rows->size(); i += step) {
+			DisassemblyResult& row = (*rows)[i];
+			if(row.CpuAddress < 0) {
 				continue;
 			}
 
 			if(
-				(!options.SearchBackwards && prevAddress < startAddress && rows[i].CpuAddress >= startAddress) ||
-				(options.SearchBackwards && prevAddress > startAddress && rows[i].CpuAddress <= startAddress) ||
+				(!options.SearchBackwards && prevAddress < startAddress && row.CpuAddress >= startAddress) ||
+				(options.SearchBackwards && prevAddress > startAddress && row.CpuAddress <= startAddress) ||
 				rowCounter > 500000
 			) {
 				if(rowCounter > 0) {
@@ -74,11 +407,11 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 
 			rowCounter++;
 
-			prevAddress = rows[i].CpuAddress;
+			prevAddress = row.CpuAddress;
 
-			_disassembler->GetLineData(rows[i], cpuType, memType, lineData);
+			_disassembler->GetLineData(row, cpuType, memType, lineData);
 
-			if(TextContains(searchStr, lineData.Text, 1000, options)) {
+			if(MatchesLine(lineData, searchStr, options, txt)) {
 				searchResults[resultCount] = lineData;
 				if(maxResultCount == ++resultCount) {
 					return resultCount;
@@ -86,31 +419,6 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 				continue;
 			}
 
-			if(TextContains(searchStr, lineData.Comment, 1000, options)) {
-				searchResults[resultCount] = lineData;
-				if(maxResultCount == ++resultCount) {
-					return resultCount;
-				}
-				continue;
-			}
-
-			if(lineData.EffectiveAddress.ShowAddress && lineData.EffectiveAddress.Address >= 0) {
-				txt = _labelManager->GetLabel({ (int32_t)lineData.EffectiveAddress.Address, lineData.EffectiveAddress.Type });
-				if(txt.empty()) {
-					txt = "[$" + DebugUtilities::AddressToHex(lineData.LineCpuType, lineData.EffectiveAddress.Address) + "]";
-				} else {
-					txt = "[" + txt + "]";
-				}
-
-				if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
-					searchResults[resultCount] = lineData;
-					if(maxResultCount == ++resultCount) {
-						return resultCount;
-					}
-					continue;
-				}
-			}
-
 			if(maxResultCount == 1 && lineData.EffectiveAddress.ValueSize > 0) {
 				txt = "$" + (lineData.EffectiveAddress.ValueSize == 2 ? HexUtilities::ToHex((uint16_t)lineData.Value) : HexUtilities::ToHex((uint8_t)lineData.Value));
 				if(TextContains(searchStr, txt.c_str(), (int)txt.size(), options)) {
@@ -134,11 +442,12 @@ uint32_t DisassemblySearch::SearchDisassembly(CpuType cpuType, const char* searc
 			nextBank = 0;
 		}
 		bank = (uint16_t)nextBank;
-		rows = _disassembler->Disassemble(cpuType, bank);
-		if(rows.empty()) {
+		snapshot = _disassembler->GetSnapshot(cpuType, bank);
+		rows = &snapshot->Rows;
+		if(rows->empty()) {
 			return resultCount;
 		}
-		startRow = options.SearchBackwards ? (int32_t)rows.size() - 1 : 0;
+		startRow = options.SearchBackwards ? (int32_t)rows->size() - 1 : 0;
 	} while(true);
 
 	return resultCount;
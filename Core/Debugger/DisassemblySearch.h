@@ -3,9 +3,15 @@
 #include "Debugger/DisassemblyInfo.h"
 #include "Debugger/DebugTypes.h"
 #include "Debugger/DebugUtilities.h"
+#include "Utilities/SimpleLock.h"
+#include <unordered_map>
+#include <thread>
+#include <mutex>
+#include <condition_variable>
 
 class Disassembler;
 class LabelManager;
+struct DisassemblySnapshot;
 enum class CpuType : uint8_t;
 
 struct DisassemblySearchOptions
@@ -16,21 +22,102 @@ struct DisassemblySearchOptions
 	bool SkipFirstLine;
 };
 
+struct DisassemblySearchIndex
+{
+	static constexpr uint32_t SkipRow = 0xFFFFFFFF;
+	static constexpr uint32_t DynamicRow = 0xFFFFFFFE;
+
+	shared_ptr<DisassemblySnapshot> Snapshot;
+	uint32_t DisplayKey = 0;
+
+	//Searchable strings for each row (text, comment and effective address, each null-terminated)
+	//Rows that depend on the CPU state or on RAM contents are marked as DynamicRow and are generated at search time
+	string Text;
+	vector<uint32_t> RowOffsets;
+	bool HasDynamicRows = false;
+
+	//1 bit per pair of (lowercase) characters found in the text, used to skip banks that can't contain a match
+	vector<uint64_t> CharPairs;
+
+	bool MayContain(const string& needle);
+};
+
+struct DisassemblySearchIndexEntry
+{
+	shared_ptr<DisassemblySearchIndex> Index;
+	uint32_t LastUsed = 0;
+};
+
+struct DisassemblySearchJob
+{
+	uint32_t SearchId = 0;
+	CpuType Cpu = {};
+	string Needle;
+	DisassemblySearchOptions Options = {};
+	uint32_t MaxResultCount = 0;
+
+	//Banks are handed out to the workers in order, results are returned in bank order
+	uint32_t BankCount = 0;
+	uint32_t NextBank = 0;
+	uint32_t LastBank = 0;
+	uint32_t ActiveWorkers = 0;
+	vector<vector<CodeLineData>> BankResults;
+	vector<uint8_t> BankDone;
+
+	//Number of banks at the start of the list that have been searched, and their result count
+	uint32_t DoneBankCount = 0;
+	uint32_t ResultCount = 0;
+};
+
 class DisassemblySearch
 {
 private:
 	Disassembler* _disassembler;
 	LabelManager* _labelManager;
 
+	//Each index keeps its bank's snapshot alive, so only keep the most recently used ones
+	static constexpr uint32_t MaxIndexCount = 32;
+
+	SimpleLock _indexLock;
+	std::unordered_map<uint32_t, DisassemblySearchIndexEntry> _indexes;
+	uint32_t _indexCounter = 0;
+
+	//ID of the most recent search that was cancelled (IDs are provided by the caller and increase with each search)
+	atomic<uint32_t> _cancelledSearchId;
+
+	//Persistent worker threads used by StartFindOccurrences, created on the first search
+	static constexpr uint32_t MaxWorkerCount = 8;
+	vector<std::thread> _workers;
+	std::mutex _jobLock;
+	std::condition_variable _jobSignal;
+	shared_ptr<DisassemblySearchJob> _job;
+	bool _stopWorkers = false;
+
+	bool IsCancelled(uint32_t searchId);
+	bool IsJobFinished(DisassemblySearchJob& job);
+	void WorkerThread();
+
 	uint32_t SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options, CodeLineData searchResults[], uint32_t maxResultCount);
 
+	uint32_t GetDisplayKey();
+	shared_ptr<DisassemblySearchIndex> GetIndex(CpuType cpuType, uint16_t bank);
+	shared_ptr<DisassemblySearchIndex> BuildIndex(CpuType cpuType, shared_ptr<DisassemblySnapshot> snapshot);
+	void SearchBank(CpuType cpuType, uint16_t bank, string& needle, DisassemblySearchOptions& options, bool skipFirstRow, uint32_t maxResultCount, uint32_t searchId, vector<CodeLineData>& results);
+	bool MatchesLine(CodeLineData& lineData, string& needle, DisassemblySearchOptions& options, string& txt);
+	void GetEffectiveAddressText(CodeLineData& lineData, string& out);
+
 	template<bool matchCase> bool TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options);
 	bool TextContains(string& needle, const char* hay, int size, DisassemblySearchOptions& options);
 	bool IsWordSeparator(char c);
 
 public:
 	DisassemblySearch(Disassembler* disassembler, LabelManager* labelManager);
+	~DisassemblySearch();
+
+	void StopWorkers();
 
 	int32_t SearchDisassembly(CpuType cpuType, const char* searchString, int32_t startAddress, DisassemblySearchOptions options);
-	uint32_t FindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, CodeLineData output[], uint32_t maxResultCount);
+	void StartFindOccurrences(CpuType cpuType, const char* searchString, DisassemblySearchOptions options, uint32_t maxResultCount, uint32_t searchId);
+	bool GetFindOccurrencesResults(uint32_t searchId, uint32_t startIndex, CodeLineData output[], uint32_t maxResultCount, uint32_t& resultCount);
+	void CancelSearch(uint32_t searchId);
 };
\ No newline at end of file
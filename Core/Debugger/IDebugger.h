@@ -39,6 +39,9 @@ public:
 	bool CheckStepBack() { return _stepBackManager->CheckStepBack(); }
 	bool IsStepBack() { return _stepBackManager->IsRewinding(); }
 	void ResetStepBackCache() { return _stepBackManager->ResetCache(); }
+	void ResetStepBackCheckpoints() { return _stepBackManager->ResetCheckpoints(); }
+	void ProcessStepBackCheckpoint() { _stepBackManager->ProcessCheckpoint(); }
+	CheckpointRingStats GetStepBackCheckpointStats() { return _stepBackManager->GetCheckpointStats(); }
 	void StepBack(int32_t stepCount) { return _stepBackManager->StepBack((StepBackType)stepCount); }
 	virtual StepBackConfig GetStepBackConfig() { return { GetCpuCycleCount(), 0, 0 }; }
 
@@ -7,18 +7,22 @@
 LabelManager::LabelManager(Debugger *debugger)
 {
 	_debugger = debugger;
+	_version = 0;
 }
 
 void LabelManager::ClearLabels()
 {
 	DebugBreakHelper helper(_debugger);
+	std::unique_lock<std::shared_mutex> lock(_lock);
 	_codeLabels.clear();
 	_codeLabelReverseLookup.clear();
+	_version++;
 }
 
 void LabelManager::SetLabel(uint32_t address, MemoryType memType, string label, string comment)
 {
 	DebugBreakHelper helper(_debugger);
+	std::unique_lock<std::shared_mutex> lock(_lock);
 	uint64_t key = GetLabelKey(address, memType);
 
 	auto existingLabel = _codeLabels.find(key);
@@ -40,6 +44,7 @@ void LabelManager::SetLabel(uint32_t address, MemoryType memType, string label,
 		_codeLabels.emplace(key, labelInfo);
 		_codeLabelReverseLookup.emplace(label, key);
 	}
+	_version++;
 }
 
 int64_t LabelManager::GetLabelKey(uint32_t absoluteAddr, MemoryType memType)
@@ -74,6 +79,7 @@ bool LabelManager::InternalGetLabel(AddressInfo address, string &label)
 {
 	int64_t key = GetLabelKey(address.Address, address.Type);
 	if(key >= 0) {
+		std::shared_lock<std::shared_mutex> lock(_lock);
 		auto result = _codeLabels.find(key);
 		if(result != _codeLabels.end()) {
 			label = result->second.Label;
@@ -88,6 +94,7 @@ string LabelManager::GetComment(AddressInfo absAddress)
 	uint64_t key = GetLabelKey(absAddress.Address, absAddress.Type);
 
 	if(key >= 0) {
+		std::shared_lock<std::shared_mutex> lock(_lock);
 		auto result = _codeLabels.find(key);
 		if(result != _codeLabels.end()) {
 			return result->second.Comment;
@@ -107,6 +114,7 @@ bool LabelManager::GetLabelAndComment(AddressInfo address, LabelInfo &labelInfo)
 		int64_t key = GetLabelKey(address.Address, address.Type);
 
 		if(key >= 0) {
+			std::shared_lock<std::shared_mutex> lock(_lock);
 			auto result = _codeLabels.find(key);
 			if(result != _codeLabels.end()) {
 				labelInfo = result->second;
@@ -119,12 +127,14 @@ bool LabelManager::GetLabelAndComment(AddressInfo address, LabelInfo &labelInfo)
 
 bool LabelManager::ContainsLabel(string &label)
 {
+	std::shared_lock<std::shared_mutex> lock(_lock);
 	return _codeLabelReverseLookup.find(label) != _codeLabelReverseLookup.end();
 }
 
 AddressInfo LabelManager::GetLabelAbsoluteAddress(string& label)
 {
 	AddressInfo addr = { -1, MemoryType::None };
+	std::shared_lock<std::shared_mutex> lock(_lock);
 	auto result = _codeLabelReverseLookup.find(label);
 	if(result != _codeLabelReverseLookup.end()) {
 		uint64_t key = result->second;
@@ -136,6 +146,7 @@ AddressInfo LabelManager::GetLabelAbsoluteAddress(string& label)
 
 int32_t LabelManager::GetLabelRelativeAddress(string &label, CpuType cpuType)
 {
+	std::shared_lock<std::shared_mutex> lock(_lock);
 	auto result = _codeLabelReverseLookup.find(label);
 	if(result == _codeLabelReverseLookup.end()) {
 		//Label doesn't exist, try to find a matching multi-byte label
@@ -144,6 +155,8 @@ int32_t LabelManager::GetLabelRelativeAddress(string &label, CpuType cpuType)
 
 	if(result != _codeLabelReverseLookup.end()) {
 		uint64_t key = result->second;
+		lock.unlock();
+
 		MemoryType type = GetKeyMemoryType(key);
 		AddressInfo addr { (int32_t)(key & 0xFFFFFFFF), type };
 		if(DebugUtilities::IsRelativeMemory(type)) {
@@ -164,6 +177,7 @@ bool LabelManager::HasLabelOrComment(AddressInfo address)
 	if(address.Address >= 0) {
 		uint64_t key = GetLabelKey(address.Address, address.Type);
 		if(key >= 0) {
+			std::shared_lock<std::shared_mutex> lock(_lock);
 			return _codeLabels.find(key) != _codeLabels.end();
 		}
 	}
@@ -2,6 +2,8 @@
 #include "pch.h"
 #include <unordered_map>
 #include <functional>
+#include <mutex>
+#include <shared_mutex>
 #include "Debugger/DebugTypes.h"
 
 class Debugger;
@@ -30,6 +32,10 @@ private:
 
 	Debugger *_debugger;
 
+	//Labels are read by the disassembler's background thread and the search workers while the UI thread edits them
+	std::shared_mutex _lock;
+	atomic<uint32_t> _version;
+
 	int64_t GetLabelKey(uint32_t absoluteAddr, MemoryType memType);
 	MemoryType GetKeyMemoryType(uint64_t key);
 	bool InternalGetLabel(AddressInfo address, string& label);
@@ -50,4 +56,7 @@ public:
 	bool ContainsLabel(string &label);
 
 	bool HasLabelOrComment(AddressInfo address);
+
+	//Incremented every time a label is added, removed or modified
+	uint32_t GetVersion() { return _version; }
 };
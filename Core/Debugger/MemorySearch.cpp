@@ -0,0 +1,311 @@
+#include "pch.h"
+#include "Debugger/MemorySearch.h"
+#include "Debugger/MemoryDumper.h"
+
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MEMORY_SEARCH_SSE2
+#endif
+
+MemorySearch::MemorySearch(MemoryDumper* memoryDumper)
+{
+	_memoryDumper = memoryDumper;
+}
+
+MemorySearchSession* MemorySearch::GetSession(MemoryType type)
+{
+	auto result = _sessions.find(type);
+	if(result == _sessions.end()) {
+		return nullptr;
+	}
+	return result->second.get();
+}
+
+MemorySearchSession* MemorySearch::GetValidSession(MemoryType type)
+{
+	MemorySearchSession* session = GetSession(type);
+	if(!session || session->RefreshSnapshot.size() != _memoryDumper->GetMemorySize(type)) {
+		//Memory size changed (e.g different game was loaded), start over
+		ResetSearch(type);
+		session = GetSession(type);
+	}
+	return session;
+}
+
+void MemorySearch::ReadMemory(MemoryType type, vector<uint8_t>& out)
+{
+	out.resize(_memoryDumper->GetMemorySize(type));
+	if(out.size()) {
+		_memoryDumper->GetMemoryState(type, out.data());
+	}
+}
+
+uint32_t MemorySearch::CountBits(uint64_t value)
+{
+	value = value - ((value >> 1) & 0x5555555555555555ULL);
+	value = (value & 0x3333333333333333ULL) + ((value >> 2) & 0x3333333333333333ULL);
+	value = (value + (value >> 4)) & 0x0F0F0F0F0F0F0F0FULL;
+	return (uint32_t)((value * 0x0101010101010101ULL) >> 56);
+}
+
+template<typename T, bool bigEndian>
+T MemorySearch::ReadValue(const uint8_t* data, uint32_t addr, uint32_t size)
+{
+	typedef typename std::make_unsigned<T>::type U;
+	U value = 0;
+	if(addr + sizeof(T) <= size) {
+		memcpy(&value, data + addr, sizeof(T));
+		if constexpr(bigEndian && sizeof(T) == 2) {
+			value = (U)((value >> 8) | (value << 8));
+		} else if constexpr(bigEndian && sizeof(T) == 4) {
+			value = (U)((value >> 24) | ((value >> 8) & 0xFF00) | ((value << 8) & 0xFF0000) | (value << 24));
+		}
+	} else {
+		//Bytes past the end of the memory are treated as 0
+		for(uint32_t i = 0; i < sizeof(T); i++) {
+			uint8_t byte = addr + i < size ? data[addr + i] : 0;
+			if constexpr(bigEndian) {
+				value |= (U)((U)byte << ((sizeof(T) - 1 - i) * 8));
+			} else {
+				value |= (U)((U)byte << (i * 8));
+			}
+		}
+	}
+	return (T)value;
+}
+
+uint32_t MemorySearch::ReadRawValue(const vector<uint8_t>& data, uint32_t addr, uint8_t valueSize, bool bigEndian)
+{
+	uint32_t size = (uint32_t)data.size();
+	switch(valueSize) {
+		default:
+		case 1: return ReadValue<uint8_t, false>(data.data(), addr, size);
+		case 2: return bigEndian ? ReadValue<uint16_t, true>(data.data(), addr, size) : ReadValue<uint16_t, false>(data.data(), addr, size);
+		case 4: return bigEndian ? ReadValue<uint32_t, true>(data.data(), addr, size) : ReadValue<uint32_t, false>(data.data(), addr, size);
+	}
+}
+
+#ifdef MEMORY_SEARCH_SSE2
+template<bool isSigned>
+static uint64_t Compare64Bytes(const uint8_t* curr, const uint8_t* prev, uint8_t value, MemorySearchOperator op)
+{
+	//SSE2 only has signed byte comparisons - flip the top bit of each byte to compare unsigned values
+	__m128i bias = _mm_set1_epi8(isSigned ? 0 : (char)0x80);
+	__m128i constant = _mm_set1_epi8((char)value);
+
+	uint64_t result = 0;
+	for(int i = 0; i < 4; i++) {
+		__m128i a = _mm_xor_si128(_mm_loadu_si128((const __m128i*)(curr + i * 16)), bias);
+		__m128i b = _mm_xor_si128(prev ? _mm_loadu_si128((const __m128i*)(prev + i * 16)) : constant, bias);
+
+		uint32_t bits;
+		switch(op) {
+			default:
+			case MemorySearchOperator::Equal: bits = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)); break;
+			case MemorySearchOperator::NotEqual: bits = _mm_movemask_epi8(_mm_cmpeq_epi8(a, b)) ^ 0xFFFF; break;
+			case MemorySearchOperator::LessThan: bits = _mm_movemask_epi8(_mm_cmplt_epi8(a, b)); break;
+			case MemorySearchOperator::GreaterThan: bits = _mm_movemask_epi8(_mm_cmpgt_epi8(a, b)); break;
+			case MemorySearchOperator::LessThanOrEqual: bits = _mm_movemask_epi8(_mm_cmpgt_epi8(a, b)) ^ 0xFFFF; break;
+			case MemorySearchOperator::GreaterThanOrEqual: bits = _mm_movemask_epi8(_mm_cmplt_epi8(a, b)) ^ 0xFFFF; break;
+		}
+		result |= (uint64_t)bits << (i * 16);
+	}
+	return result;
+}
+#endif
+
+template<typename T, bool bigEndian>
+void MemorySearch::ApplyFilter(MemorySearchSession& session, MemorySearchFilter& filter)
+{
+	uint32_t size = (uint32_t)session.RefreshSnapshot.size();
+	const uint8_t* curr = session.RefreshSnapshot.data();
+	const uint8_t* prev = nullptr;
+	T constValue = 0;
+
+	switch(filter.CompareTo) {
+		case MemorySearchCompareTo::PreviousSearchValue: prev = session.SearchSnapshot.data(); break;
+		case MemorySearchCompareTo::PreviousRefreshValue: prev = session.PrevRefreshSnapshot.data(); break;
+		case MemorySearchCompareTo::SpecificValue: constValue = (T)filter.SpecificValue; break;
+		case MemorySearchCompareTo::SpecificAddress: constValue = ReadValue<T, bigEndian>(curr, filter.SpecificAddress, size); break;
+	}
+
+	//Values are compared 64 addresses at a time (1 word of the candidate bitset), blocks without candidates are skipped
+	T a[64];
+	T b[64];
+	uint32_t count = 0;
+	for(size_t w = 0; w < session.Candidates.size(); w++) {
+		uint64_t candidates = session.Candidates[w];
+		if(candidates == 0) {
+			continue;
+		}
+
+		uint32_t base = (uint32_t)w * 64;
+		uint64_t matches = 0;
+
+#ifdef MEMORY_SEARCH_SSE2
+		if(sizeof(T) == 1 && base + 64 <= size) {
+			matches = Compare64Bytes<std::is_signed<T>::value>(curr + base, prev ? prev + base : nullptr, (uint8_t)constValue, filter.Operator);
+		} else
+#endif
+		{
+			for(uint32_t i = 0; i < 64; i++) {
+				a[i] = ReadValue<T, bigEndian>(curr, base + i, size);
+				b[i] = prev ? ReadValue<T, bigEndian>(prev, base + i, size) : constValue;
+			}
+
+			switch(filter.Operator) {
+				case MemorySearchOperator::Equal: for(uint32_t i = 0; i < 64; i++) { matches |= (uint64_t)(a[i] == b[i]) << i; } break;
+				case MemorySearchOperator::NotEqual: for(uint32_t i = 0; i < 64; i++) { matches |= (uint64_t)(a[i] != b[i]) << i; } break;
+				case MemorySearchOperator::LessThan: for(uint32_t i = 0; i < 64; i++) { matches |= (uint64_t)(a[i] < b[i]) << i; } break;
+				case MemorySearchOperator::GreaterThan: for(uint32_t i = 0; i < 64; i++) { matches |= (uint64_t)(a[i] > b[i]) << i; } break;
+				case MemorySearchOperator::LessThanOrEqual: for(uint32_t i = 0; i < 64; i++) { matches |= (uint64_t)(a[i] <= b[i]) << i; } break;
+				case MemorySearchOperator::GreaterThanOrEqual: for(uint32_t i = 0; i < 64; i++) { matches |= (uint64_t)(a[i] >= b[i]) << i; } break;
+			}
+		}
+
+		candidates &= matches;
+		session.Candidates[w] = candidates;
+		count += CountBits(candidates);
+	}
+
+	session.CandidateCount = count;
+}
+
+void MemorySearch::ResetSearch(MemoryType type)
+{
+	auto lock = _lock.AcquireSafe();
+
+	unique_ptr<MemorySearchSession>& session = _sessions[type];
+	session.reset(new MemorySearchSession());
+	ReadMemory(type, session->RefreshSnapshot);
+	session->PrevRefreshSnapshot = session->RefreshSnapshot;
+	session->SearchSnapshot = session->RefreshSnapshot;
+
+	uint32_t size = (uint32_t)session->RefreshSnapshot.size();
+	session->Candidates.assign((size + 63) / 64, ~0ULL);
+	if(size & 0x3F) {
+		//Clear the bits past the end of the memory
+		session->Candidates.back() = (1ULL << (size & 0x3F)) - 1;
+	}
+	session->CandidateCount = size;
+}
+
+void MemorySearch::RefreshSnapshot(MemoryType type)
+{
+	auto lock = _lock.AcquireSafe();
+	MemorySearchSession* session = GetValidSession(type);
+	std::swap(session->PrevRefreshSnapshot, session->RefreshSnapshot);
+	ReadMemory(type, session->RefreshSnapshot);
+}
+
+uint32_t MemorySearch::AddFilter(MemoryType type, MemorySearchFilter filter)
+{
+	auto lock = _lock.AcquireSafe();
+
+	MemorySearchSession* session = GetValidSession(type);
+
+	size_t maxUndoCount = std::max<size_t>(1, std::min(MemorySearch::MaxUndoCount, MemorySearch::MaxUndoSize / std::max<size_t>(1, session->Candidates.size() * sizeof(uint64_t))));
+	session->UndoHistory.push_back({ session->Candidates, session->CandidateCount });
+	while(session->UndoHistory.size() > maxUndoCount) {
+		session->UndoHistory.pop_front();
+	}
+
+	switch(filter.ValueSize) {
+		default:
+		case 1:
+			if(filter.IsSigned) {
+				ApplyFilter<int8_t, false>(*session, filter);
+			} else {
+				ApplyFilter<uint8_t, false>(*session, filter);
+			}
+			break;
+
+		case 2:
+			if(filter.IsSigned) {
+				filter.BigEndian ? ApplyFilter<int16_t, true>(*session, filter) : ApplyFilter<int16_t, false>(*session, filter);
+			} else {
+				filter.BigEndian ? ApplyFilter<uint16_t, true>(*session, filter) : ApplyFilter<uint16_t, false>(*session, filter);
+			}
+			break;
+
+		case 4:
+			if(filter.IsSigned) {
+				filter.BigEndian ? ApplyFilter<int32_t, true>(*session, filter) : ApplyFilter<int32_t, false>(*session, filter);
+			} else {
+				filter.BigEndian ? ApplyFilter<uint32_t, true>(*session, filter) : ApplyFilter<uint32_t, false>(*session, filter);
+			}
+			break;
+	}
+
+	session->SearchSnapshot = session->RefreshSnapshot;
+	return session->CandidateCount;
+}
+
+bool MemorySearch::Undo(MemoryType type)
+{
+	auto lock = _lock.AcquireSafe();
+	MemorySearchSession* session = GetSession(type);
+	if(!session || session->UndoHistory.empty()) {
+		return false;
+	}
+
+	//Only the candidates are restored, "previous search value" filters keep comparing against the last search's values
+	MemorySearchUndoEntry& entry = session->UndoHistory.back();
+	session->Candidates = std::move(entry.Candidates);
+	session->CandidateCount = entry.CandidateCount;
+	session->UndoHistory.pop_back();
+	return true;
+}
+
+uint32_t MemorySearch::GetResultCount(MemoryType type)
+{
+	auto lock = _lock.AcquireSafe();
+	MemorySearchSession* session = GetSession(type);
+	return session ? session->CandidateCount : 0;
+}
+
+uint32_t MemorySearch::GetResults(MemoryType type, uint32_t startIndex, uint8_t valueSize, bool bigEndian, MemorySearchResult results[], uint32_t maxResultCount)
+{
+	auto lock = _lock.AcquireSafe();
+	MemorySearchSession* session = GetSession(type);
+	if(!session) {
+		return 0;
+	}
+
+	uint32_t skipped = 0;
+	uint32_t count = 0;
+	for(size_t w = 0; w < session->Candidates.size() && count < maxResultCount; w++) {
+		uint64_t candidates = session->Candidates[w];
+		if(candidates == 0) {
+			continue;
+		}
+
+		uint32_t bitCount = CountBits(candidates);
+		if(skipped + bitCount <= startIndex) {
+			//Whole block is before the requested page
+			skipped += bitCount;
+			continue;
+		}
+
+		for(uint32_t i = 0; i < 64 && count < maxResultCount; i++) {
+			if(!(candidates & (1ULL << i))) {
+				continue;
+			}
+
+			if(skipped < startIndex) {
+				skipped++;
+				continue;
+			}
+
+			uint32_t addr = (uint32_t)w * 64 + i;
+			MemorySearchResult& result = results[count];
+			result.Address = addr;
+			result.Value = ReadRawValue(session->RefreshSnapshot, addr, valueSize, bigEndian);
+			result.PrevRefreshValue = ReadRawValue(session->PrevRefreshSnapshot, addr, valueSize, bigEndian);
+			result.PrevSearchValue = ReadRawValue(session->SearchSnapshot, addr, valueSize, bigEndian);
+			count++;
+		}
+	}
+
+	return count;
+}
@@ -0,0 +1,104 @@
+#pragma once
+#include "pch.h"
+#include <unordered_map>
+#include "Shared/MemoryType.h"
+#include "Utilities/SimpleLock.h"
+
+class MemoryDumper;
+
+enum class MemorySearchCompareTo
+{
+	PreviousSearchValue,
+	PreviousRefreshValue,
+	SpecificValue,
+	SpecificAddress
+};
+
+enum class MemorySearchOperator
+{
+	Equal,
+	NotEqual,
+	LessThan,
+	GreaterThan,
+	LessThanOrEqual,
+	GreaterThanOrEqual
+};
+
+struct MemorySearchFilter
+{
+	MemorySearchCompareTo CompareTo;
+	MemorySearchOperator Operator;
+	uint8_t ValueSize;
+	bool IsSigned;
+	bool BigEndian;
+	uint32_t SpecificValue;
+	uint32_t SpecificAddress;
+};
+
+struct MemorySearchResult
+{
+	uint32_t Address;
+	uint32_t Value;
+	uint32_t PrevRefreshValue;
+	uint32_t PrevSearchValue;
+};
+
+struct MemorySearchUndoEntry
+{
+	vector<uint64_t> Candidates;
+	uint32_t CandidateCount;
+};
+
+struct MemorySearchSession
+{
+	//Memory state when the last filter was applied
+	vector<uint8_t> SearchSnapshot;
+
+	//Memory state at the last 2 refreshes - filters are applied to the latest one
+	vector<uint8_t> RefreshSnapshot;
+	vector<uint8_t> PrevRefreshSnapshot;
+
+	//1 bit per address, set when the address still matches all filters
+	vector<uint64_t> Candidates;
+	uint32_t CandidateCount = 0;
+
+	deque<MemorySearchUndoEntry> UndoHistory;
+};
+
+class MemorySearch
+{
+private:
+	static constexpr size_t MaxUndoCount = 100;
+
+	//Undo entries only contain the candidate bitset (1 bit per address), limit their total size for large memory types
+	static constexpr size_t MaxUndoSize = 16 * 1024 * 1024;
+
+	MemoryDumper* _memoryDumper = nullptr;
+
+	SimpleLock _lock;
+	std::unordered_map<MemoryType, unique_ptr<MemorySearchSession>> _sessions;
+
+	MemorySearchSession* GetSession(MemoryType type);
+	MemorySearchSession* GetValidSession(MemoryType type);
+	void ReadMemory(MemoryType type, vector<uint8_t>& out);
+
+	template<typename T, bool bigEndian>
+	void ApplyFilter(MemorySearchSession& session, MemorySearchFilter& filter);
+
+	template<typename T, bool bigEndian>
+	static T ReadValue(const uint8_t* data, uint32_t addr, uint32_t size);
+
+	static uint32_t ReadRawValue(const vector<uint8_t>& data, uint32_t addr, uint8_t valueSize, bool bigEndian);
+	static uint32_t CountBits(uint64_t value);
+
+public:
+	MemorySearch(MemoryDumper* memoryDumper);
+
+	void ResetSearch(MemoryType type);
+	void RefreshSnapshot(MemoryType type);
+	uint32_t AddFilter(MemoryType type, MemorySearchFilter filter);
+	bool Undo(MemoryType type);
+
+	uint32_t GetResultCount(MemoryType type);
+	uint32_t GetResults(MemoryType type, uint32_t startIndex, uint8_t valueSize, bool bigEndian, MemorySearchResult results[], uint32_t maxResultCount);
+};
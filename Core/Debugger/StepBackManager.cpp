@@ -2,13 +2,17 @@
 #include "Debugger/StepBackManager.h"
 #include "Debugger/IDebugger.h"
 #include "Shared/Emulator.h"
+#include "Shared/EmuSettings.h"
 #include "Shared/SaveStateManager.h"
 #include "Shared/NotificationManager.h"
 #include "Shared/RewindManager.h"
+#include "Shared/BaseControlManager.h"
+#include "Shared/Interfaces/IConsole.h"
 
-StepBackManager::StepBackManager(Emulator* emu, IDebugger* debugger)
+StepBackManager::StepBackManager(Emulator* emu, IDebugger* debugger) : _checkpoints(emu)
 {
 	_emu = emu;
+	_settings = emu->GetSettings();
 	_rewindManager = emu->GetRewindManager();
 	_debugger = debugger;
 }
@@ -29,10 +33,73 @@ void StepBackManager::StepBack(StepBackType type)
 		
 		_active = true;
 		_allowRetry = true;
+		_replayingCheckpoint = false;
 		_stateClockLimit = StepBackManager::DefaultClockLimit;
 	}
 }
 
+bool StepBackManager::IsCheckpointSegment(uint32_t frameCount, uint32_t pollCounter)
+{
+	return _checkpointFrame == frameCount && _checkpointPollCounter == pollCounter;
+}
+
+bool StepBackManager::StartReplay()
+{
+	//Checkpoints can only be replayed when no frame ended and no input was polled since they were taken.
+	//Otherwise the replay would need the rewind manager's input logs and frame counters, use a regular rewind instead.
+	IConsole* console = _emu->GetConsoleUnsafe();
+	if(!_checkpoints.IsEmpty() && _targetClock > 0 && IsCheckpointSegment(console->GetPpuFrame().FrameCount, console->GetControlManager()->GetPollCounter())) {
+		if(_checkpoints.LoadCheckpoint(_targetClock - 1)) {
+			_replayingCheckpoint = true;
+			return true;
+		}
+	}
+
+	_replayingCheckpoint = false;
+	_rewindManager->StartRewinding(true);
+	return false;
+}
+
+void StepBackManager::StopReplay(bool deleteFutureData)
+{
+	if(!_replayingCheckpoint) {
+		_rewindManager->StopRewinding(true, deleteFutureData);
+	}
+	_replayingCheckpoint = false;
+}
+
+void StepBackManager::ProcessCheckpoint()
+{
+	uint32_t interval = _settings->GetDebugConfig().StepBackCheckpointInterval;
+	if(interval == 0) {
+		return;
+	}
+
+	StepBackConfig cfg = _debugger->GetStepBackConfig();
+	if(cfg.CurrentCycle < _nextCheckpointClock || cfg.CyclesPerScanline == 0) {
+		return;
+	}
+
+	uint64_t intervalClocks = (uint64_t)interval * cfg.CyclesPerScanline;
+	IConsole* console = _emu->GetConsoleUnsafe();
+	uint32_t frameCount = console->GetPpuFrame().FrameCount;
+	uint32_t pollCounter = console->GetControlManager()->GetPollCounter();
+
+	if(!IsCheckpointSegment(frameCount, pollCounter) || cfg.CurrentCycle < _checkpoints.GetNewestClock()) {
+		//Only the checkpoints taken since the last frame/input poll can be replayed, discard the rest
+		_checkpoints.Clear();
+		_checkpointFrame = frameCount;
+		_checkpointPollCounter = pollCounter;
+	} else if(!_checkpoints.IsEmpty() && cfg.CurrentCycle < _checkpoints.GetNewestClock() + intervalClocks) {
+		//Last checkpoint is still recent (e.g after step back removed the more recent ones)
+		_nextCheckpointClock = _checkpoints.GetNewestClock() + intervalClocks;
+		return;
+	}
+
+	_checkpoints.AddCheckpoint(cfg.CurrentCycle);
+	_nextCheckpointClock = cfg.CurrentCycle + intervalClocks;
+}
+
 bool StepBackManager::CheckStepBack()
 {
 	if(!_active) {
@@ -41,7 +108,7 @@ bool StepBackManager::CheckStepBack()
 
 	uint64_t clock = _debugger->GetStepBackConfig().CurrentCycle;
 
-	if(!_rewindManager->IsStepBack()) {
+	if(!_replayingCheckpoint && !_rewindManager->IsStepBack()) {
 		if(_cache.size() > 1) {
 			//Check to see if previous instruction is already in cache
 			if(_cache.back().Clock == _targetClock) {
@@ -54,6 +121,8 @@ bool StepBackManager::CheckStepBack()
 					_emu->GetRewindManager()->StopRewinding(true, true);
 					_active = false;
 					_prevClock = clock;
+					_checkpoints.RemoveAfter(_cache.back().Clock);
+					_nextCheckpointClock = 0;
 					return true;
 				}
 			} else {
@@ -63,8 +132,9 @@ bool StepBackManager::CheckStepBack()
 		}
 
 		//Start rewinding on next instruction after StepBack() is called
+		//Use the closest checkpoint when possible, otherwise rewind to the start of the rewind manager's current block
 		_cache.clear();
-		_rewindManager->StartRewinding(true);
+		StartReplay();
 		clock = _debugger->GetStepBackConfig().CurrentCycle;
 	}
 
@@ -79,21 +149,25 @@ bool StepBackManager::CheckStepBack()
 		//If the CPU is back to where it was before step back, check if the cache contains data
 		if(_cache.size() > 0) {
 			_emu->Deserialize(_cache.back().SaveState, SaveStateManager::FileFormatVersion, true, std::nullopt, false);
-			_rewindManager->StopRewinding(true, true);
+			StopReplay(true);
 		} else if(_allowRetry && clock > _prevClock && (clock - _prevClock) > StepBackManager::DefaultClockLimit) {
 			//Cache is empty, this can happen when a single instruction takes more than X clocks (e.g block transfers, dma)
 			//In this case, re-run the step back process again but start recordings state earlier
-			_rewindManager->StopRewinding(true);
-			_rewindManager->StartRewinding(true);
+			StopReplay(false);
+			StartReplay();
 			_stateClockLimit = (clock - _prevClock) + StepBackManager::DefaultClockLimit;
 			_allowRetry = false;
 			return false;
 		} else {
 			//Stop rewinding, even if the target was not found
-			_rewindManager->StopRewinding(true);
+			StopReplay(false);
 		}
 		_active = false;
 		_prevClock = clock;
+
+		//Any checkpoint past the current position is no longer part of the execution history
+		_checkpoints.RemoveAfter(_debugger->GetStepBackConfig().CurrentCycle);
+		_nextCheckpointClock = 0;
 		return true;
 	}
 
@@ -1,8 +1,10 @@
 #pragma once
 #include "pch.h"
 #include "Shared/RewindManager.h"
+#include "Debugger/CheckpointRing.h"
 
 class Emulator;
+class EmuSettings;
 class IDebugger;
 
 struct StepBackCacheEntry
@@ -31,6 +33,7 @@ private:
 	static constexpr uint64_t DefaultClockLimit = 600; //Default to 600 clocks to avoid retry when NES sprite DMA occurs (~512 cycles)
 
 	Emulator* _emu = nullptr;
+	EmuSettings* _settings = nullptr;
 	RewindManager* _rewindManager = nullptr;
 	IDebugger* _debugger = nullptr;
 
@@ -41,12 +44,25 @@ private:
 	bool _allowRetry = false;
 	uint64_t _stateClockLimit = StepBackManager::DefaultClockLimit;
 
+	CheckpointRing _checkpoints;
+	uint64_t _nextCheckpointClock = 0;
+	uint32_t _checkpointFrame = 0;
+	uint32_t _checkpointPollCounter = 0;
+	bool _replayingCheckpoint = false;
+
+	bool IsCheckpointSegment(uint32_t frameCount, uint32_t pollCounter);
+	bool StartReplay();
+	void StopReplay(bool deleteFutureData);
+
 public:
 	StepBackManager(Emulator* emu, IDebugger* debugger);
 
 	void StepBack(StepBackType type);
 	bool CheckStepBack();
+	void ProcessCheckpoint();
 
 	void ResetCache() { _cache.clear(); }
+	void ResetCheckpoints() { _checkpoints.Clear(); _nextCheckpointClock = 0; }
+	CheckpointRingStats GetCheckpointStats() { return _checkpoints.GetStats(); }
 	bool IsRewinding() { return _active || _rewindManager->IsRewinding(); }
 };
\ No newline at end of file
@@ -70,6 +70,22 @@ public:
 		return addr & 0x01 ? (addr >> 9) : (addr >> 1);
 	}
 
+	template<uint8_t width>
+	__forceinline bool TryReadRom(uint32_t addr, uint32_t& value)
+	{
+		//Aligned halfword/word read, only possible when the whole value is within the rom and doesn't touch the GPIO ports
+		if(_gpio && addr >= 0x80000C4 && addr <= 0x80000C9) {
+			return false;
+		}
+
+		addr &= 0x1FFFFFF;
+		if(addr + width <= _prgRomSize) {
+			memcpy(&value, _prgRom + addr, width);
+			return true;
+		}
+		return false;
+	}
+
 	void WriteRom(uint32_t addr, uint8_t value);
 
 	uint8_t ReadRam(uint32_t addr, uint32_t readAddr);
@@ -315,9 +315,7 @@ uint32_t GbaMemoryManager::Read(GbaAccessModeVal mode, uint32_t addr)
 		value = isSigned ? (uint32_t)(int8_t)value : (uint8_t)value;
 		_emu->ProcessMemoryRead<CpuType::Gba, 1>(addr, value, MemoryOperationType::Read);
 	} else if(mode & GbaAccessMode::HalfWord) {
-		uint8_t b0 = InternalRead(mode, addr & ~0x01, addr);
-		uint8_t b1 = InternalRead(mode, addr | 1, addr);
-		value = b0 | (b1 << 8);
+		value = InternalRead<2>(mode, addr & ~0x01, addr);
 		UpdateOpenBus<2>(addr, value);
 		value = isSigned ? (uint32_t)(int16_t)value : (uint16_t)value;
 		if(!(mode & GbaAccessMode::NoRotate) && (addr & 0x01)) {
@@ -325,11 +323,7 @@ uint32_t GbaMemoryManager::Read(GbaAccessModeVal mode, uint32_t addr)
 		}
 		_emu->ProcessMemoryRead<CpuType::Gba, 2>(addr & ~0x01, value, mode & GbaAccessMode::Prefetch ? MemoryOperationType::ExecOpCode : MemoryOperationType::Read);
 	} else {
-		uint8_t b0 = InternalRead(mode, addr & ~0x03, addr);
-		uint8_t b1 = InternalRead(mode, (addr & ~0x03) | 1, addr);
-		uint8_t b2 = InternalRead(mode, (addr & ~0x03) | 2, addr);
-		uint8_t b3 = InternalRead(mode, addr | 3, addr);
-		value = b0 | (b1 << 8) | (b2 << 16) | (b3 << 24);
+		value = InternalRead<4>(mode, addr & ~0x03, addr);
 		UpdateOpenBus<4>(addr, value);
 		if(!(mode & GbaAccessMode::NoRotate) && (addr & 0x03)) {
 			value = RotateValue(mode, addr, value, isSigned);
@@ -371,19 +365,96 @@ void GbaMemoryManager::Write(GbaAccessModeVal mode, uint32_t addr, uint32_t valu
 		}
 	} else if(mode & GbaAccessMode::HalfWord) {
 		if(_emu->ProcessMemoryWrite<CpuType::Gba, 2>(addr & ~0x01, value, MemoryOperationType::Write)) {
-			InternalWrite(mode, addr & ~0x01, (uint8_t)value, addr, value);
-			InternalWrite(mode, (addr & ~0x01) | 0x01, (uint8_t)(value >> 8), addr, value);
+			InternalWrite<2>(mode, addr & ~0x01, value, addr);
 		}
 	} else {
 		if(_emu->ProcessMemoryWrite<CpuType::Gba, 4>(addr & ~0x03, value, MemoryOperationType::Write)) {
-			InternalWrite(mode, (addr & ~0x03), (uint8_t)value, addr, value);
-			InternalWrite(mode, (addr & ~0x03) | 0x01, (uint8_t)(value >> 8), addr, value);
-			InternalWrite(mode, (addr & ~0x03) | 0x02, (uint8_t)(value >> 16), addr, value);
-			InternalWrite(mode, (addr & ~0x03) | 0x03, (uint8_t)(value >> 24), addr, value);
+			InternalWrite<4>(mode, addr & ~0x03, value, addr);
 		}
 	}
 }
 
+template<uint8_t width>
+uint32_t GbaMemoryManager::InternalRead(GbaAccessModeVal mode, uint32_t addr, uint32_t readAddr)
+{
+	//Aligned halfword/word reads to memory that's stored as a plain little endian array are done with a single load
+	uint32_t value = 0;
+	uint32_t offset = addr & 0xFFFFFF;
+	switch(addr >> 24) {
+		case 0x02: memcpy(&value, _extWorkRam + (offset & (GbaConsole::ExtWorkRamSize - 1)), width); return value;
+		case 0x03: memcpy(&value, _intWorkRam + (offset & (GbaConsole::IntWorkRamSize - 1)), width); return value;
+		case 0x05: memcpy(&value, _palette + (offset & (GbaConsole::PaletteRamSize - 1)), width); return value;
+
+		case 0x06:
+			if(offset & 0x10000) {
+				if(offset >= 0x18000 && _ppu->IsBitmapMode() && !(offset & 0x4000)) {
+					//reads to mirrors of the first 0x4000 when in bitmap mode return 0 instead
+					return 0;
+				}
+				memcpy(&value, _vram + (offset & 0x17FFF), width);
+			} else {
+				memcpy(&value, _vram + (offset & 0xFFFF), width);
+			}
+			return value;
+
+		case 0x07: memcpy(&value, _oam + (offset & (GbaConsole::SpriteRamSize - 1)), width); return value;
+
+		case 0x08:
+		case 0x09:
+		case 0x0A:
+		case 0x0B:
+		case 0x0C:
+			if(_cart->TryReadRom<width>(addr, value)) {
+				return value;
+			}
+			break;
+	}
+
+	//Everything else (bios, registers, gpio, eeprom, save ram, open bus) is read one byte at a time
+	for(int i = 0; i < width; i++) {
+		value |= InternalRead(mode, addr | i, readAddr) << (i * 8);
+	}
+	return value;
+}
+
+template<uint8_t width>
+void GbaMemoryManager::InternalWrite(GbaAccessModeVal mode, uint32_t addr, uint32_t value, uint32_t writeAddr)
+{
+	uint32_t offset = addr & 0xFFFFFF;
+	switch(addr >> 24) {
+		case 0x02: memcpy(_extWorkRam + (offset & (GbaConsole::ExtWorkRamSize - 1)), &value, width); break;
+
+		case 0x03:
+			memcpy(_intWorkRam + (offset & (GbaConsole::IntWorkRamSize - 1)), &value, width);
+			memcpy(_state.IwramOpenBus + (offset & (4 - width)), &value, width);
+			break;
+
+		case 0x05: memcpy(_palette + (offset & (GbaConsole::PaletteRamSize - 1)), &value, width); break;
+
+		case 0x06:
+			if(offset & 0x10000) {
+				if(offset >= 0x18000 && _ppu->IsBitmapMode() && !(offset & 0x4000)) {
+					//Ignore writes to mirrors of the first 0x4000 when in bitmap mode
+					break;
+				}
+				memcpy(_vram + (offset & 0x17FFF), &value, width);
+			} else {
+				memcpy(_vram + (offset & 0xFFFF), &value, width);
+			}
+			break;
+
+		case 0x07: memcpy(_oam + (offset & (GbaConsole::SpriteRamSize - 1)), &value, width); break;
+
+		default:
+			for(int i = 0; i < width; i++) {
+				InternalWrite(mode, addr | i, (uint8_t)(value >> (i * 8)), writeAddr, value);
+			}
+			return;
+	}
+
+	memcpy(_state.InternalOpenBus + (offset & (4 - width)), &value, width);
+}
+
 uint8_t GbaMemoryManager::InternalRead(GbaAccessModeVal mode, uint32_t addr, uint32_t readAddr)
 {
 	uint8_t bank = (addr >> 24);
@@ -88,6 +88,9 @@ private:
 	__forceinline uint8_t InternalRead(GbaAccessModeVal mode, uint32_t addr, uint32_t readAddr);
 	__forceinline void InternalWrite(GbaAccessModeVal mode, uint32_t addr, uint8_t value, uint32_t writeAddr, uint32_t fullValue);
 
+	template<uint8_t width> __forceinline uint32_t InternalRead(GbaAccessModeVal mode, uint32_t addr, uint32_t readAddr);
+	template<uint8_t width> __forceinline void InternalWrite(GbaAccessModeVal mode, uint32_t addr, uint32_t value, uint32_t writeAddr);
+
 	uint32_t ReadRegister(uint32_t addr);
 	void WriteRegister(GbaAccessModeVal mode, uint32_t addr, uint8_t value);
 
@@ -19,6 +19,7 @@
 #include "Shared/NotificationManager.h"
 #include "Utilities/BitUtilities.h"
 #include "Utilities/Serializer.h"
+#include "Utilities/SimdUtilities.h"
 #include "Utilities/StaticFor.h"
 
 void GbaPpu::Init(Emulator* emu, GbaConsole* console, GbaMemoryManager* memoryManager)
@@ -288,6 +289,19 @@ void GbaPpu::ProcessColorMath()
 	int start = _lastRenderCycle < 46 ? 0 : std::max(0, ((_lastRenderCycle - 46) / 4) + 1);
 	int end = std::min((_state.Cycle - 46) / 4, 239);
 
+	//Resolve the colors and coefficients for each pixel first, then blend them all at once
+	//Pixels without any effect use coefficients 16/0, which leaves their color unchanged
+	uint16_t colorA[GbaConstants::ScreenWidth];
+	uint16_t colorB[GbaConstants::ScreenWidth];
+	uint16_t coeffA[GbaConstants::ScreenWidth];
+	uint16_t coeffB[GbaConstants::ScreenWidth];
+	auto setPixel = [&](int x, uint16_t a, uint8_t aCoeff, uint16_t b, uint8_t bCoeff) {
+		colorA[x] = a;
+		coeffA[x] = aCoeff;
+		colorB[x] = b;
+		coeffB[x] = bCoeff;
+	};
+
 	for(int x = start; x <= end; x++) {
 		if constexpr(windowEnabled) {
 			wnd = _activeWindow[x];
@@ -324,30 +338,32 @@ void GbaPpu::ProcessColorMath()
 
 		if((main.Color & (GbaPpu::SpriteBlendFlag | GbaPpu::DirectColorFlag)) == GbaPpu::SpriteBlendFlag && _state.BlendSub[sub.Layer]) {
 			//Sprite transparency is applied before anything else
-			BlendColors(dst, x, ReadColor<false>(x, main.Color), mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
+			setPixel(x, ReadColor<false>(x, main.Color), mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
 		} else {
 			if constexpr(effect == GbaPpuBlendEffect::None) {
-				dst[x] = ReadColor<false>(x, main.Color);
+				setPixel(x, ReadColor<false>(x, main.Color), 16, 0, 0);
 			} else if constexpr(effect == GbaPpuBlendEffect::AlphaBlend) {
 				if(_state.BlendSub[sub.Layer]) {
 					if(!_state.BlendMain[main.Layer] || !_state.WindowActiveLayers[wnd][GbaPpu::EffectLayerIndex]) {
-						dst[x] = ReadColor<false>(x, main.Color);
+						setPixel(x, ReadColor<false>(x, main.Color), 16, 0, 0);
 					} else {
-						BlendColors(dst, x, ReadColor<false>(x, main.Color), mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
+						setPixel(x, ReadColor<false>(x, main.Color), mainCoeff, ReadColor<true>(x, sub.Color), subCoeff);
 					}
 				} else {
-					dst[x] = ReadColor<false>(x, main.Color);
+					setPixel(x, ReadColor<false>(x, main.Color), 16, 0, 0);
 				}
 			} else {
 				if(brightness == 0 || !_state.BlendMain[main.Layer] || !_state.WindowActiveLayers[wnd][GbaPpu::EffectLayerIndex]) {
-					dst[x] = ReadColor<false>(x, main.Color);
+					setPixel(x, ReadColor<false>(x, main.Color), 16, 0, 0);
 				} else {
-					BlendColors(dst, x, ReadColor<false>(x, main.Color), 16 - brightness, blendColor, brightness);
+					setPixel(x, ReadColor<false>(x, main.Color), 16 - brightness, blendColor, brightness);
 				}
 			}
 		}
 	}
 
+	BlendColors(dst, colorA, coeffA, colorB, coeffB, start, end);
+
 	if(_state.StereoscopicEnabled) {
 		for(int x = start & ~1; x + 1 <= end; x+=2) {
 			uint16_t gLeft = dst[x] & 0x3E0;
@@ -369,21 +385,42 @@ uint16_t GbaPpu::ReadColor(int x, uint16_t addr)
 	}
 }
 
-void GbaPpu::BlendColors(uint16_t* dst, int x, uint16_t main, uint8_t aCoeff, uint16_t sub, uint8_t bCoeff)
+void GbaPpu::BlendColors(uint16_t* dst, uint16_t* colorA, uint16_t* coeffA, uint16_t* colorB, uint16_t* coeffB, int start, int end)
 {
-	uint8_t aR = main & 0x1F;
-	uint8_t aG = (main >> 5) & 0x1F;
-	uint8_t aB = (main >> 10) & 0x1F;
+	int x = start;
+#ifdef MESEN_SSE2
+	for(; x + 8 <= end + 1; x += 8) {
+		__m128i a = _mm_loadu_si128((__m128i*)(colorA + x));
+		__m128i b = _mm_loadu_si128((__m128i*)(colorB + x));
+		__m128i aCoeff = _mm_loadu_si128((__m128i*)(coeffA + x));
+		__m128i bCoeff = _mm_loadu_si128((__m128i*)(coeffB + x));
+
+		__m128i result = SimdUtilities::BlendRgb555(a, b, [aCoeff, bCoeff](__m128i channelA, __m128i channelB) {
+			__m128i value = _mm_add_epi16(_mm_mullo_epi16(channelA, aCoeff), _mm_mullo_epi16(channelB, bCoeff));
+			return _mm_min_epi16(_mm_srli_epi16(value, 4), _mm_set1_epi16(0x1F));
+		});
+		_mm_storeu_si128((__m128i*)(dst + x), result);
+	}
+#endif
 
-	uint8_t bR = sub & 0x1F;
-	uint8_t bG = (sub >> 5) & 0x1F;
-	uint8_t bB = (sub >> 10) & 0x1F;
+	for(; x <= end; x++) {
+		uint16_t main = colorA[x];
+		uint16_t sub = colorB[x];
 
-	uint32_t r = std::min(31, (aR * aCoeff + bR * bCoeff) >> 4);
-	uint32_t g = std::min(31, (aG * aCoeff + bG * bCoeff) >> 4);
-	uint32_t b = std::min(31, (aB * aCoeff + bB * bCoeff) >> 4);
+		uint8_t aR = main & 0x1F;
+		uint8_t aG = (main >> 5) & 0x1F;
+		uint8_t aB = (main >> 10) & 0x1F;
 
-	dst[x] = r | (g << 5) | (b << 10);
+		uint8_t bR = sub & 0x1F;
+		uint8_t bG = (sub >> 5) & 0x1F;
+		uint8_t bB = (sub >> 10) & 0x1F;
+
+		uint32_t r = std::min(31, (aR * coeffA[x] + bR * coeffB[x]) >> 4);
+		uint32_t g = std::min(31, (aG * coeffA[x] + bG * coeffB[x]) >> 4);
+		uint32_t b = std::min(31, (aB * coeffA[x] + bB * coeffB[x]) >> 4);
+
+		dst[x] = r | (g << 5) | (b << 10);
+	}
 }
 
 void GbaPpu::InitializeWindows()
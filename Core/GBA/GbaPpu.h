@@ -184,7 +184,7 @@ private:
 
 	template<GbaPpuBlendEffect effect, bool bg0Enabled, bool bg1Enabled, bool bg2Enabled, bool bg3Enabled, bool windowEnabled> void ProcessColorMath();
 
-	void BlendColors(uint16_t* dst, int x, uint16_t a, uint8_t aCoeff, uint16_t b, uint8_t bCoeff);
+	void BlendColors(uint16_t* dst, uint16_t* colorA, uint16_t* coeffA, uint16_t* colorB, uint16_t* coeffB, int start, int end);
 	template<bool isSubColor> uint16_t ReadColor(int x, uint16_t addr);
 
 	void InitializeWindows();
@@ -26,6 +26,7 @@ public:
 	GbDmaControllerState GetState();
 
 	void Exec();
+	__forceinline bool IsOamDmaPending() { return _state.DmaCounter > 0 || _state.DmaStartDelay > 0; }
 
 	uint8_t GetLastWriteAddress();
 
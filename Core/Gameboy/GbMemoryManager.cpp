@@ -81,7 +81,7 @@ void GbMemoryManager::ExecTimerDmaSerial()
 {
 	_state.ApuCycleCount += _state.CgbHighSpeed ? 1 : 2;
 	_timer->Exec();
-	if((_cpu->GetState().CycleCount & 0x03) == 0) {
+	if((_cpu->GetState().CycleCount & 0x03) == 0 && _dmaController->IsOamDmaPending()) {
 		_dmaController->Exec();
 	}
 
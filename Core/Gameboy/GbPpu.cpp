@@ -544,6 +544,7 @@ void GbPpu::ResetRenderer()
 
 	_drawnPixels = -8 - (_state.ScrollX & 0x07);
 	_fetchSprite = -1;
+	_nextSpriteX = INT16_MIN;
 	_fetchWindow = false;
 	_fetchColumn = 0;
 
@@ -598,16 +599,25 @@ void GbPpu::ClockSpriteFetcher()
 
 void GbPpu::FindNextSprite()
 {
-	if(_fetchSprite < 0 && (_state.SpritesEnabled || _state.CgbEnabled)) {
-		for(int i = 0; i < _spriteCount; i++) {
-			if((int)_spriteX[i] - 8 == _drawnPixels) {
-				_fetchSprite = i;
-				_spriteX[i] = 0xFF; //Prevent processing the same sprite again
-				_oamFetcher.Step = 0;
-				break;
-			}
+	//Sprites are only fetched when the current X position matches their X coordinate exactly,
+	//so nothing needs to be done until the closest remaining sprite's position is reached
+	if(_fetchSprite >= 0 || _drawnPixels < _nextSpriteX) {
+		return;
+	}
+
+	bool spritesEnabled = _state.SpritesEnabled || _state.CgbEnabled;
+	int16_t nextSpriteX = INT16_MAX;
+	for(int i = 0; i < _spriteCount; i++) {
+		int16_t sprX = (int16_t)_spriteX[i] - 8;
+		if(spritesEnabled && _fetchSprite < 0 && sprX == _drawnPixels) {
+			_fetchSprite = i;
+			_spriteX[i] = 0xFF; //Prevent processing the same sprite again
+			_oamFetcher.Step = 0;
+		} else if(sprX >= _drawnPixels && sprX < nextSpriteX) {
+			nextSpriteX = sprX;
 		}
 	}
+	_nextSpriteX = nextSpriteX;
 }
 
 void GbPpu::ClockTileFetcher()
@@ -1334,6 +1344,8 @@ void GbPpu::Serialize(Serializer& s)
 		if(!_state.LcdEnabled) {
 			_lcdDisabled = true;
 		}
+
+		_nextSpriteX = INT16_MIN;
 	}
 }
 
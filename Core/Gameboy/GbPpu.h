@@ -44,6 +44,7 @@ private:
 	bool _insertGlitchBgPixel = false;
 
 	int16_t _fetchSprite = -1;
+	int16_t _nextSpriteX = INT16_MIN;
 	uint8_t _spriteCount = 0;
 	uint8_t _spriteX[10] = {};
 	uint8_t _spriteY[10] = {};
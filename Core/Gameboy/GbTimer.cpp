@@ -15,6 +15,7 @@ void GbTimer::Init(GbMemoryManager* memoryManager, GbApu* apu)
 	//Passes boot_div-dmgABCmgb
 	//But that test depends on LCD power on timings, so may be wrong.
 	_state.Divider = 0x06;
+	_idleSteps = 0;
 }
 
 GbTimer::~GbTimer()
@@ -26,7 +27,7 @@ GbTimerState GbTimer::GetState()
 	return _state;
 }
 
-void GbTimer::Exec()
+void GbTimer::ExecStep()
 {
 	if((_state.Divider & 0x03) == 2) {
 		_state.Reloaded = false;
@@ -35,6 +36,28 @@ void GbTimer::Exec()
 		}
 	}
 	SetDivider(_state.Divider + 2);
+
+	_idleSteps = GetIdleSteps();
+}
+
+uint32_t GbTimer::GetIdleSteps()
+{
+	if(_state.NeedReload || _state.Reloaded) {
+		return 0;
+	}
+
+	//Returns the number of steps before the given divider bit goes from 1 to 0 (the divider is incremented by 2 on each step)
+	auto getStepsToFallingEdge = [=](uint32_t bit) {
+		uint32_t nextEdge = ((uint32_t)_state.Divider | ((bit << 1) - 1)) + 1;
+		return (nextEdge - _state.Divider + 1) >> 1;
+	};
+
+	//The frame sequencer uses bit 13 in double speed mode - its falling edges are a subset of bit 12's
+	uint32_t steps = getStepsToFallingEdge(0x1000);
+	if(_state.TimerEnabled) {
+		steps = std::min(steps, getStepsToFallingEdge(_state.TimerDivider));
+	}
+	return steps - 1;
 }
 
 void GbTimer::ReloadCounter()
@@ -81,6 +104,8 @@ uint8_t GbTimer::Read(uint16_t addr)
 
 void GbTimer::Write(uint16_t addr, uint8_t value)
 {
+	_idleSteps = 0;
+
 	switch(addr) {
 		case 0xFF04:
 			SetDivider(0);
@@ -147,4 +172,8 @@ void GbTimer::Write(uint16_t addr, uint8_t value)
 void GbTimer::Serialize(Serializer& s)
 {
 	SV(_state.Divider); SV(_state.Counter); SV(_state.Modulo); SV(_state.Control); SV(_state.TimerEnabled); SV(_state.TimerDivider); SV(_state.NeedReload); SV(_state.Reloaded);
+
+	if(!s.IsSaving()) {
+		_idleSteps = 0;
+	}
 }
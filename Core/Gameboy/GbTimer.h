@@ -13,10 +13,16 @@ private:
 	GbMemoryManager* _memoryManager = nullptr;
 	GbApu* _apu = nullptr;
 	GbTimerState _state = {};
+
+	//Number of upcoming Exec() calls that only need to increment the divider
+	uint32_t _idleSteps = 0;
 	
 	void SetDivider(uint16_t value);
 	void ReloadCounter();
 
+	void ExecStep();
+	uint32_t GetIdleSteps();
+
 public:
 	virtual ~GbTimer();
 
@@ -24,7 +30,16 @@ public:
 
 	GbTimerState GetState();
 
-	void Exec();
+	__forceinline void Exec()
+	{
+		if(_idleSteps) {
+			//No timer/frame sequencer clock or TIMA reload can happen on this step
+			_idleSteps--;
+			_state.Divider += 2;
+		} else {
+			ExecStep();
+		}
+	}
 	
 	bool IsFrameSequencerBitSet();
 
@@ -180,6 +180,20 @@ void BaseMapper::SetCpuMemoryMapping(uint16_t startAddr, uint16_t endAddr, uint8
 
 		sourceOffset += 0x100;
 	}
+
+	UpdateDirectReadPages(startAddr, endAddr);
+}
+
+void BaseMapper::UpdateDirectReadPages(uint16_t startPage, uint16_t endPage)
+{
+	for(uint16_t i = startPage; i <= endPage; i++) {
+		bool hasReadRegister = _allowRegisterRead && _isReadRegisterPage[i];
+		if(!_hasCustomReadRam && !hasReadRegister && (_prgMemoryAccess[i] & MemoryAccessType::Read)) {
+			_directReadPages[i] = _prgPages[i];
+		} else {
+			_directReadPages[i] = nullptr;
+		}
+	}
 }
 
 void BaseMapper::RemoveCpuMemoryMapping(uint16_t startAddr, uint16_t endAddr)
@@ -536,11 +550,13 @@ void BaseMapper::AddRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOp
 	for(int i = startAddr; i <= endAddr; i++) {
 		if((int)operation & (int)MemoryOperation::Read) {
 			_isReadRegisterAddr[i] = true;
+			_isReadRegisterPage[i >> 8] = true;
 		}
 		if((int)operation & (int)MemoryOperation::Write) {
 			_isWriteRegisterAddr[i] = true;
 		}
 	}
+	UpdateDirectReadPages(startAddr >> 8, endAddr >> 8);
 }
 
 void BaseMapper::RemoveRegisterRange(uint16_t startAddr, uint16_t endAddr, MemoryOperation operation)
@@ -553,6 +569,21 @@ void BaseMapper::RemoveRegisterRange(uint16_t startAddr, uint16_t endAddr, Memor
 			_isWriteRegisterAddr[i] = false;
 		}
 	}
+
+	if((int)operation & (int)MemoryOperation::Read) {
+		//A page may still contain other read registers outside of the removed range
+		for(int page = startAddr >> 8; page <= (endAddr >> 8); page++) {
+			bool hasReadRegister = false;
+			for(int i = 0; i < 0x100; i++) {
+				if(_isReadRegisterAddr[(page << 8) | i]) {
+					hasReadRegister = true;
+					break;
+				}
+			}
+			_isReadRegisterPage[page] = hasReadRegister;
+		}
+		UpdateDirectReadPages(startAddr >> 8, endAddr >> 8);
+	}
 }
 
 void BaseMapper::Serialize(Serializer& s)
@@ -633,10 +664,12 @@ void BaseMapper::Initialize(NesConsole* console, RomData& romData)
 	_allowRegisterRead = AllowRegisterRead();
 	_hasCpuClockHook = EnableCpuClockHook();
 	_hasCustomReadVram = EnableCustomVramRead();
+	_hasCustomReadRam = EnableCustomReadRam();
 	_hasVramAddressHook = EnableVramAddressHook();
 
 	memset(_isReadRegisterAddr, 0, sizeof(_isReadRegisterAddr));
 	memset(_isWriteRegisterAddr, 0, sizeof(_isWriteRegisterAddr));
+	memset(_isReadRegisterPage, 0, sizeof(_isReadRegisterPage));
 	AddRegisterRange(RegisterStartAddress(), RegisterEndAddress(), MemoryOperation::Any);
 
 	_prgSize = (uint32_t)romData.PrgRom.size();
@@ -695,6 +728,7 @@ void BaseMapper::Initialize(NesConsole* console, RomData& romData)
 	for(int i = 0; i < 0x100; i++) {
 		//Allow us to map a different page every 256 bytes
 		_prgPages[i] = nullptr;
+		_directReadPages[i] = nullptr;
 		_prgMemoryOffset[i] = -1;
 		_prgMemoryType[i] = PrgMemoryType::PrgRom;
 		_prgMemoryAccess[i] = MemoryAccessType::NoAccess;
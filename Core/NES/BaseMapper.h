@@ -28,6 +28,7 @@ private:
 	uint16_t InternalGetChrRomPageSize();
 	uint16_t InternalGetChrRamPageSize();
 	bool ValidateAddressRange(uint16_t startAddr, uint16_t endAddr);
+	void UpdateDirectReadPages(uint16_t startPage, uint16_t endPage);
 
 	uint8_t *_nametableRam = nullptr;
 	uint8_t _nametableCount = 2;
@@ -39,16 +40,21 @@ private:
 	bool _hasDefaultWorkRam = false;
 	
 	bool _hasCustomReadVram = false;
+	bool _hasCustomReadRam = false;
 	bool _hasCpuClockHook = false;
 	bool _hasVramAddressHook = false;
 
 	bool _allowRegisterRead = false;
 	bool _isReadRegisterAddr[0x10000] = {};
 	bool _isWriteRegisterAddr[0x10000] = {};
+	bool _isReadRegisterPage[0x100] = {};
 
 	MemoryAccessType _prgMemoryAccess[0x100] = {};
 	uint8_t* _prgPages[0x100] = {};
 
+	//Same as _prgPages, but only set for readable pages that contain no read registers (used by NesMemoryManager to skip ReadRam)
+	uint8_t* _directReadPages[0x100] = {};
+
 	MemoryAccessType _chrMemoryAccess[0x100] = {};
 	uint8_t* _chrPages[0x100] = {};
 
@@ -114,6 +120,7 @@ protected:
 
 	virtual bool EnableCpuClockHook() { return false; }
 	virtual bool EnableCustomVramRead() { return false; }
+	virtual bool EnableCustomReadRam() { return false; }
 	virtual bool EnableVramAddressHook() { return false; }
 
 	virtual uint32_t GetDipSwitchCount() { return 0; }
@@ -216,6 +223,8 @@ public:
 	__forceinline bool HasVramAddressHook() { return _hasVramAddressHook; }
 	virtual void NotifyVramAddressChange(uint16_t addr);
 
+	__forceinline bool HasCustomReadVram() { return _hasCustomReadVram; }
+
 	virtual void GetMemoryRanges(MemoryRanges &ranges) override;
 	virtual uint32_t GetInternalRamSize() { return 0x800; }
 
@@ -226,6 +235,9 @@ public:
 
 	uint8_t ReadRam(uint16_t addr) override;
 	uint8_t PeekRam(uint16_t addr) override;
+
+	__forceinline uint8_t* GetDirectReadPage(uint16_t addr) { return _directReadPages[addr >> 8]; }
+
 	uint8_t DebugReadRam(uint16_t addr);
 	void WriteRam(uint16_t addr, uint8_t value) override;
 	void DebugWriteRam(uint16_t addr, uint8_t value);
@@ -124,6 +124,27 @@ public:
 	virtual void Reset(bool softReset) = 0;
 	virtual void Run(uint64_t runTo) = 0;
 
+	void CatchUp(uint64_t runTo)
+	{
+		if(_masterClock + _masterClockDivider <= runTo) {
+			Run(runTo);
+		}
+	}
+
+	uint64_t GetNextSyncClock()
+	{
+		//Returns the clock at which the PPU next does something the CPU can see without accessing a register
+		//(start of a scanline, or vblank/NMI flag changes on dot 1 of the NMI and pre-render scanlines)
+		uint32_t dots;
+		if(_cycle == 0 && (_scanline == _nmiScanline || _scanline == -1)) {
+			dots = 1;
+		} else {
+			//Also correct when the pre-render scanline's last dot is skipped on odd frames
+			dots = _cycle < 340 ? 340 - _cycle : 1;
+		}
+		return _masterClock + dots * _masterClockDivider;
+	}
+
 	uint32_t GetFrameCount() { return _frameCount; }
 	uint32_t GetCurrentCycle() { return _cycle; }
 	int32_t GetCurrentScanline() { return _scanline; }
@@ -149,6 +149,7 @@ protected:
 	bool AllowRegisterRead() override { return true; }
 	bool EnableCpuClockHook() override { return true; }
 	bool EnableCustomVramRead() override { return true; }
+	bool EnableCustomReadRam() override { return true; }
 
 	void InitMapper() override;
 	void SaveBattery() override;
@@ -257,6 +257,7 @@ void NesConsole::UpdateRegion(bool forceUpdate)
 		_region = region;
 
 		_cpu->SetMasterClockDivider(_region);
+		_cpu->ResetPpuSync();
 		_mapper->SetRegion(_region);
 		_ppu->UpdateTimings(_region);
 		_apu->SetRegion(_region);
@@ -290,6 +291,9 @@ void NesConsole::RunFrame()
 		//Re-update timings to allow overclocking
 		_ppu->UpdateTimings(_region, true);
 	}
+
+	//Timings may have changed, and the PPU needs to be up to date for save states/rewind taken between frames
+	_cpu->SyncPpu();
 }
 
 void NesConsole::RunVsSubConsole()
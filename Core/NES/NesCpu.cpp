@@ -9,6 +9,7 @@
 #include "NES/NesMemoryManager.h"
 #include "NES/NesControlManager.h"
 #include "NES/NesConsole.h"
+#include "NES/BaseMapper.h"
 #include "Shared/MessageManager.h"
 #include "Shared/EmuSettings.h"
 #include "Shared/Emulator.h"
@@ -137,6 +138,7 @@ void NesCpu::Reset(bool softReset, ConsoleRegion region)
 
 	_state.CycleCount = (uint64_t)-1;
 	_masterClock = 0;
+	_ppuSyncClock = 0;
 
 	uint8_t cpuOffset = 0;
 	if(_console->GetNesConfig().RandomizeCpuPpuAlignment) {
@@ -294,7 +296,9 @@ uint16_t NesCpu::FetchOperand()
 void NesCpu::EndCpuCycle(bool forRead)
 {
 	_masterClock += forRead ? (_endClockCount + 1) : (_endClockCount - 1);
-	_console->GetPpu()->Run(_masterClock - _ppuOffset);
+	if(_masterClock >= _ppuSyncClock) {
+		SyncPpu();
+	}
 
 	//"The internal signal goes high during φ1 of the cycle that follows the one where the edge is detected,
 	//and stays high until the NMI has been handled. "
@@ -318,10 +322,30 @@ void NesCpu::StartCpuCycle(bool forRead)
 {
 	_masterClock += forRead ? (_startClockCount - 1) : (_startClockCount + 1);
 	_state.CycleCount++;
-	_console->GetPpu()->Run(_masterClock - _ppuOffset);
+	if(_masterClock >= _ppuSyncClock) {
+		SyncPpu();
+	}
 	_console->ProcessCpuClock();
 }
 
+void NesCpu::SyncPpu()
+{
+	BaseNesPpu* ppu = _console->GetPpu();
+	ppu->CatchUp(_masterClock - _ppuOffset);
+
+	//The PPU can lag behind the CPU until its next scanline/NMI edge, as long as nothing needs to observe it on every cycle.
+	//Register accesses ($2000+) call this before reaching the PPU/APU/mapper, so they always see an up-to-date PPU.
+	BaseMapper* mapper = _console->GetMapper();
+	if(
+		_emu->IsDebugging() || mapper->HasCpuClockHook() || mapper->HasVramAddressHook() || mapper->HasCustomReadVram() ||
+		_console->GetNesConfig().EnableOamDecay || _console->GetVsSubConsole() || !_console->IsVsMainConsole()
+	) {
+		_ppuSyncClock = 0;
+	} else {
+		_ppuSyncClock = ppu->GetNextSyncClock() + _ppuOffset;
+	}
+}
+
 void NesCpu::ProcessPendingDma(uint16_t readAddress, MemoryOperationType opType)
 {
 	if(!_needHalt) {
@@ -619,4 +643,8 @@ void NesCpu::Serialize(Serializer &s)
 		SV(_prevNmiFlag);
 		SV(_needNmi);
 	}
+
+	if(!s.IsSaving()) {
+		_ppuSyncClock = 0;
+	}
 }
\ No newline at end of file
@@ -27,6 +27,7 @@ private:
 	typedef void(NesCpu::*Func)();
 
 	uint64_t _masterClock;
+	uint64_t _ppuSyncClock = 0;
 	uint8_t _ppuOffset;
 	uint8_t _startClockCount;
 	uint8_t _endClockCount;
@@ -820,6 +821,9 @@ public:
 	void StartDmcTransfer();
 	void StopDmcTransfer();
 
+	void SyncPpu();
+	void ResetPpuSync() { _ppuSyncClock = 0; }
+
 	bool IsCpuWrite() { return _cpuWrite; }
 	bool IsDmcDma() { return _isDmcDmaRead; }
 
@@ -2,6 +2,7 @@
 #include "NES/NesMemoryManager.h"
 #include "NES/BaseMapper.h"
 #include "NES/NesConsole.h"
+#include "NES/NesCpu.h"
 #include "Shared/CheatManager.h"
 #include "Shared/Emulator.h"
 #include "Shared/EmuSettings.h"
@@ -124,7 +125,19 @@ uint16_t NesMemoryManager::DebugReadWord(uint16_t addr)
 
 uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 {
-	uint8_t value = _ramReadHandlers[addr]->ReadRam(addr);
+	uint8_t value;
+	INesMemoryHandler* handler = _ramReadHandlers[addr];
+	uint8_t* page;
+	if(handler == _mapper && (page = _mapper->GetDirectReadPage(addr))) {
+		//Plain PRG ROM/RAM page, skip the virtual ReadRam call
+		value = page[(uint8_t)addr];
+	} else {
+		if(addr >= 0x2000) {
+			//Registers can expose the PPU's state, make sure it has caught up to the CPU first
+			_console->GetCpu()->SyncPpu();
+		}
+		value = handler->ReadRam(addr);
+	}
 	if(_cheatManager->HasCheats<CpuType::Nes>()) {
 		_cheatManager->ApplyCheat<CpuType::Nes>(addr, value);
 	}
@@ -138,6 +151,9 @@ uint8_t NesMemoryManager::Read(uint16_t addr, MemoryOperationType operationType)
 void NesMemoryManager::Write(uint16_t addr, uint8_t value, MemoryOperationType operationType)
 {
 	if(_emu->ProcessMemoryWrite<CpuType::Nes>(addr, value, operationType)) {
+		if(addr >= 0x2000) {
+			_console->GetCpu()->SyncPpu();
+		}
 		_ramWriteHandlers[addr]->WriteRam(addr, value);
 		_openBusHandler.SetOpenBus(value, false);
 	}
@@ -90,14 +90,15 @@ void PcePsg::Write(uint16_t addr, uint8_t value)
 		case 9: _state.LfoControl = value; break;
 	}
 
-	UpdateOutput(_emu->GetSettings()->GetPcEngineConfig());
+	UpdateGains(_emu->GetSettings()->GetPcEngineConfig());
+	UpdateOutput();
 }
 
 void PcePsg::Run()
 {
 	uint64_t clock = _console->GetMasterClock();
 	uint32_t clocksToRun = clock - _lastClock;
-	PcEngineConfig& cfg = _emu->GetSettings()->GetPcEngineConfig();
+	UpdateGains(_emu->GetSettings()->GetPcEngineConfig());
 	while(clocksToRun >= 6) {
 		uint32_t minTimer = clocksToRun / 6;
 		for(int i = 0; i < 6; i++) {
@@ -114,7 +115,7 @@ void PcePsg::Run()
 		_clockCounter += minTimer;
 		clocksToRun -= minTimer * 6;
 
-		UpdateOutput(cfg);
+		UpdateOutput();
 	}
 
 	if(_clockCounter >= 20000) {
@@ -124,14 +125,23 @@ void PcePsg::Run()
 	_lastClock = clock - clocksToRun;
 }
 
-void PcePsg::UpdateOutput(PcEngineConfig& cfg)
+void PcePsg::UpdateGains(PcEngineConfig& cfg)
+{
+	for(int i = 0; i < 6; i++) {
+		PcePsgChannel& ch = _channels[i];
+		_leftGain[i] = (int32_t)ch.GetVolume(true, _state.LeftVolume) * (int32_t)cfg.ChannelVol[i];
+		_rightGain[i] = (int32_t)ch.GetVolume(false, _state.RightVolume) * (int32_t)cfg.ChannelVol[i];
+	}
+}
+
+void PcePsg::UpdateOutput()
 {
 	int16_t leftOutput = 0;
 	int16_t rightOutput = 0;
 	for(int i = 0; i < 6; i++) {
-		PcePsgChannel& ch = _channels[i];
-		leftOutput += (int32_t)ch.GetOutput(true, _state.LeftVolume) * (int32_t)cfg.ChannelVol[i] / 100;
-		rightOutput += (int32_t)ch.GetOutput(false, _state.RightVolume) * (int32_t)cfg.ChannelVol[i] / 100;
+		int32_t output = _channels[i].GetState().CurrentOutput;
+		leftOutput += output * _leftGain[i] / 100;
+		rightOutput += output * _rightGain[i] / 100;
 	}
 
 	if(_prevLeftOutput != leftOutput) {
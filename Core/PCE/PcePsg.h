@@ -31,9 +31,14 @@ private:
 	int16_t _prevLeftOutput = 0;
 	int16_t _prevRightOutput = 0;
 
+	//Volume multiplier for each channel (channel volume, master volume and config volume), only changes on writes
+	int32_t _leftGain[6] = {};
+	int32_t _rightGain[6] = {};
+
 	uint32_t _clockCounter = 0;
 	
-	void UpdateOutput(PcEngineConfig& cfg);
+	void UpdateGains(PcEngineConfig& cfg);
+	void UpdateOutput();
 	void UpdateSoundOffset();
 
 public:
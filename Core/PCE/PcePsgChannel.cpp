@@ -93,7 +93,7 @@ void PcePsgChannel::Run(uint32_t clocks)
 	}
 }
 
-int16_t PcePsgChannel::GetOutput(bool forLeftChannel, uint8_t masterVolume)
+uint8_t PcePsgChannel::GetVolume(bool forLeftChannel, uint8_t masterVolume)
 {
 	//Sound reduction constants (in -1.5dB steps)
 	constexpr uint8_t volumeReduction[30] = { 255,214,180,151,127,107,90,76,64,53,45,38,32,27,22,19,16,13,11,9,8,6,5,4,4,3,2,2,2,1 };
@@ -104,7 +104,7 @@ int16_t PcePsgChannel::GetOutput(bool forLeftChannel, uint8_t masterVolume)
 		return 0;
 	}
 
-	return (int16_t)_state.CurrentOutput * volumeReduction[reductionFactor];
+	return volumeReduction[reductionFactor];
 }
 
 uint16_t PcePsgChannel::GetTimer()
@@ -26,7 +26,7 @@ public:
 	PcePsgChannelState& GetState() { return _state; }
 
 	void Run(uint32_t clocks);
-	int16_t GetOutput(bool forLeftChannel, uint8_t masterVolume);
+	uint8_t GetVolume(bool forLeftChannel, uint8_t masterVolume);
 	uint16_t GetTimer();
 	void Write(uint16_t addr, uint8_t value);
 
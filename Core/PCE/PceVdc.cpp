@@ -512,7 +512,6 @@ void PceVdc::LoadSpriteTiles()
 	bool removeSpriteLimit = _emu->GetSettings()->GetPcEngineConfig().RemoveSpriteLimit;
 	uint16_t clockCount = _loadSpriteStart > _loadBgStart ? (PceConstants::ClockPerScanline - _loadSpriteStart) + _loadBgStart : (_loadBgStart - _loadSpriteStart);
 	bool hasSprite0 = false;
-	memset(_xPosHasSprite, 0, sizeof(_xPosHasSprite));
 	if(_state.HvLatch.SpriteAccessMode != 1) {
 		//Modes 0/2/3 load 4 words over 4, 8 or 16 VDC clocks
 		uint16_t clocksPerSprite;
@@ -527,7 +526,6 @@ void PceVdc::LoadSpriteTiles()
 		for(int i = 0; i < _totalSpriteCount; i++) {
 			PceSpriteInfo& spr = _drawSprites[i];
 			spr = _sprites[i];
-			memset(_xPosHasSprite + spr.X + 32, 1, 16);
 			uint16_t addr = spr.TileAddress;
 			spr.TileData[0] = ReadVram(addr);
 			spr.TileData[1] = ReadVram(addr + 16);
@@ -542,7 +540,6 @@ void PceVdc::LoadSpriteTiles()
 		for(int i = 0; i < _totalSpriteCount; i++) {
 			PceSpriteInfo& spr = _drawSprites[i];
 			spr = _sprites[i];
-			memset(_xPosHasSprite + spr.X + 32, 1, 16);
 			//Load SP0/SP1 or SP2/SP3 based on flag
 			uint16_t addr = spr.TileAddress + (spr.LoadSp23 ? 32 : 0);
 			spr.TileData[0] = ReadVram(addr);
@@ -553,12 +550,44 @@ void PceVdc::LoadSpriteTiles()
 		}
 	}
 
+	ComposeSpriteLayer();
+
 	if(hasSprite0 && _drawSpriteCount > 1) {
 		//Force VDC emulation to run on each CPU cycle, to ensure any sprite 0 hit IRQ is triggered at the correct time
 		_rowHasSprite0 = true;
 	}
 }
 
+void PceVdc::ComposeSpriteLayer()
+{
+	//Decode all of the row's sprites ahead of time - the first opaque sprite (in evaluation order) is shown at each position.
+	//When that sprite is sprite 0, the next opaque sprite at the same position triggers a sprite 0 hit
+	//(unless it is only visible because of the "remove sprite limit" option)
+	memset(_spriteLayer, 0, sizeof(_spriteLayer));
+	for(int i = 0; i < _totalSpriteCount; i++) {
+		PceSpriteInfo& spr = _drawSprites[i];
+		uint16_t* layer = _spriteLayer + spr.X + 32;
+		for(int x = 0; x < 16; x++) {
+			uint8_t color = GetSpritePixelColor(spr.TileData, spr.HorizontalMirroring ? x : (15 - x));
+			if(color == 0) {
+				continue;
+			}
+
+			uint16_t& pixel = layer[x];
+			if(!(pixel & PceVdc::SpriteLayerOpaque)) {
+				pixel = (
+					PceVdc::SpriteLayerOpaque |
+					(spr.ForegroundPriority ? PceVdc::SpriteLayerForeground : 0) |
+					(spr.Index == 0 ? PceVdc::SpriteLayerSprite0 : 0) |
+					(spr.Palette * 16 + color)
+				);
+			} else if((pixel & (PceVdc::SpriteLayerSprite0 | PceVdc::SpriteLayerCovered)) == PceVdc::SpriteLayerSprite0) {
+				pixel |= PceVdc::SpriteLayerCovered | (i < _drawSpriteCount ? PceVdc::SpriteLayerHit : 0);
+			}
+		}
+	}
+}
+
 bool PceVdc::IsDmaAllowed()
 {
 	if(!_allowDma && !_state.BurstModeEnabled) {
@@ -892,46 +921,19 @@ void PceVdc::InternalDrawScanline()
 			}
 
 			if constexpr(hasSprites) {
-				if(_state.SpritesEnabled && _xPosHasSprite[_screenOffsetX + 32]) {
-					uint8_t sprColor;
-					bool checkSprite0Hit = false;
-					for(uint16_t i = 0; i < _totalSpriteCount; i++) {
-						int16_t xOffset = _screenOffsetX - _drawSprites[i].X;
-						if(xOffset >= 0 && xOffset < 16) {
-							if(!_drawSprites[i].HorizontalMirroring) {
-								xOffset = 15 - xOffset;
-							}
-
-							sprColor = GetSpritePixelColor(_drawSprites[i].TileData, xOffset);
-
-							if(sprColor != 0) {
-								if constexpr(hasSprite0) {
-									if(checkSprite0Hit) {
-										//Note: don't trigger sprite 0 hit for sprites that are drawn because of the "remove sprite limit" option
-										if(_state.EnableCollisionIrq && i < _drawSpriteCount) {
-											_state.Sprite0Hit = true;
-											_vpc->SetIrq(this);
-										}
-									} else {
-										if(sprEnabled && (bgColor == 0 || _drawSprites[i].ForegroundPriority)) {
-											outColor = PceVpc::SpritePixelFlag | _vce->GetPalette(256 + _drawSprites[i].Palette * 16 + sprColor);
-										}
-									}
-								
-									if(_drawSprites[i].Index == 0) {
-										checkSprite0Hit = true;
-									} else {
-										break;
-									}
-								} else {
-									if(sprEnabled && (bgColor == 0 || _drawSprites[i].ForegroundPriority)) {
-										outColor = PceVpc::SpritePixelFlag | _vce->GetPalette(256 + _drawSprites[i].Palette * 16 + sprColor);
-									}
-									break;
-								}
-							}
+				uint16_t sprPixel = _spriteLayer[_screenOffsetX + 32];
+				if(_state.SpritesEnabled && sprPixel) {
+					if constexpr(hasSprite0) {
+						//Note: don't trigger sprite 0 hit for sprites that are drawn because of the "remove sprite limit" option
+						if((sprPixel & PceVdc::SpriteLayerHit) && _state.EnableCollisionIrq) {
+							_state.Sprite0Hit = true;
+							_vpc->SetIrq(this);
 						}
 					}
+
+					if(sprEnabled && (bgColor == 0 || (sprPixel & PceVdc::SpriteLayerForeground))) {
+						outColor = PceVpc::SpritePixelFlag | _vce->GetPalette(256 + (sprPixel & 0xFF));
+					}
 				}
 			}
 
@@ -1472,8 +1474,6 @@ void PceVdc::Serialize(Serializer& s)
 		SV(_latchClockX);
 		SV(_latchClockY);
 
-		SVArray(_xPosHasSprite, sizeof(_xPosHasSprite));
-
 		for(int i = 0; i < _spriteCount; i++) {
 			SVI(_sprites[i].X);
 			SVI(_sprites[i].TileAddress);
@@ -1502,5 +1502,9 @@ void PceVdc::Serialize(Serializer& s)
 			SVI(_tiles[i].Palette);
 			SVI(_tiles[i].TileAddr);
 		}
+
+		if(!s.IsSaving()) {
+			ComposeSpriteLayer();
+		}
 	}
 }
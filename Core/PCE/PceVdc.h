@@ -57,6 +57,13 @@ struct PceSpriteInfo
 class PceVdc final : public ISerializable
 {
 private:
+	//Flags for _spriteLayer entries (bits 0-7 contain the sprite palette index)
+	static constexpr uint16_t SpriteLayerForeground = 0x100;
+	static constexpr uint16_t SpriteLayerSprite0 = 0x200;
+	static constexpr uint16_t SpriteLayerCovered = 0x400;
+	static constexpr uint16_t SpriteLayerHit = 0x800;
+	static constexpr uint16_t SpriteLayerOpaque = 0x8000;
+
 	PceVdcState _state = {};
 	Emulator* _emu = nullptr;
 	PceConsole* _console = nullptr;
@@ -118,7 +125,8 @@ private:
 	MemoryType _vramType = MemoryType::PceVideoRam;
 	MemoryType _spriteRamType = MemoryType::PceSpriteRam;
 
-	bool _xPosHasSprite[1024 + 32] = {};
+	//Front-most sprite pixel for each X position of the current row (offset by 32)
+	uint16_t _spriteLayer[1024 + 32] = {};
 	uint8_t _drawSpriteCount = 0;
 	uint8_t _totalSpriteCount = 0;
 	bool _rowHasSprite0 = false;
@@ -173,6 +181,7 @@ private:
 
 	__forceinline void ProcessSpriteEvaluation();
 	__noinline void LoadSpriteTiles();
+	void ComposeSpriteLayer();
 
 	bool IsDmaAllowed();
 	
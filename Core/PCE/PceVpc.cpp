@@ -13,6 +13,7 @@
 #include "Shared/NotificationManager.h"
 #include "Utilities/Serializer.h"
 #include "Shared/EventType.h"
+#include "Utilities/SimdUtilities.h"
 
 PceVpc::PceVpc(Emulator* emu, PceConsole* console, PceVce* vce)
 {
@@ -187,6 +188,76 @@ void PceVpc::ProcessScanlineStart(PceVdc* vdc, uint16_t scanline)
 	}
 }
 
+template<PceVpcPriorityMode mode>
+static __forceinline bool IsVdc2PixelVisible(uint16_t vdc1, uint16_t vdc2)
+{
+	bool isSpriteVdc1 = (vdc1 & PceVpc::SpritePixelFlag) != 0;
+	bool isSpriteVdc2 = (vdc2 & PceVpc::SpritePixelFlag) != 0;
+	bool isTransparentVdc1 = (vdc1 & PceVpc::TransparentPixelFlag) != 0;
+	bool isTransparentVdc2 = (vdc2 & PceVpc::TransparentPixelFlag) != 0;
+
+	switch(mode) {
+		default:
+		case PceVpcPriorityMode::Default:
+			return isTransparentVdc1;
+
+		case PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg:
+			//VDC2 sprites are shown above VDC1 background, but below VDC1 sprites
+			//VDC1 transparent, show VDC2, or
+			//VDC2 is a sprite and VDC1 is not a sprite, show VDC2
+			return isTransparentVdc1 || (isSpriteVdc2 && !isSpriteVdc1);
+
+		case PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg:
+			//VDC1 sprites are shown behind VDC2 background, but above VDC2 sprites(?)
+			//VDC1 transparent, show VDC2, or
+			//VDC1 is a sprite, show VDC2 (unless VDC2 is a transparent color or the background layer)
+			return isTransparentVdc1 || (isSpriteVdc1 && !isSpriteVdc2 && !isTransparentVdc2);
+	}
+}
+
+template<PceVpcPriorityMode mode>
+void PceVpc::MixLayers(uint16_t* out, uint16_t* rowBuffer, uint16_t* rowBufferVdc2, uint32_t start, uint32_t end)
+{
+	uint32_t i = start;
+#ifdef MESEN_SSE2
+	//The flags are expanded to masks by moving their bit into the sign bit: bit 15 as is, bit 14 after a 1-bit left shift
+	static_assert(PceVpc::SpritePixelFlag == 0x8000, "SSE path expects the sprite flag in bit 15");
+	static_assert(PceVpc::TransparentPixelFlag == 0x4000, "SSE path expects the transparent flag in bit 14");
+
+	for(; i + 8 <= end; i += 8) {
+		__m128i vdc1 = _mm_loadu_si128((__m128i*)(rowBuffer + i));
+		__m128i vdc2 = _mm_loadu_si128((__m128i*)(rowBufferVdc2 + i));
+
+		//Expand the sprite/transparent flags to full 16-bit masks
+		__m128i transparentVdc1 = _mm_srai_epi16(_mm_slli_epi16(vdc1, 1), 15);
+		__m128i showVdc2;
+		switch(mode) {
+			default:
+			case PceVpcPriorityMode::Default:
+				showVdc2 = transparentVdc1;
+				break;
+
+			case PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg:
+				showVdc2 = _mm_or_si128(transparentVdc1, _mm_andnot_si128(_mm_srai_epi16(vdc1, 15), _mm_srai_epi16(vdc2, 15)));
+				break;
+
+			case PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg: {
+				__m128i vdc2Flags = _mm_or_si128(_mm_srai_epi16(vdc2, 15), _mm_srai_epi16(_mm_slli_epi16(vdc2, 1), 15));
+				showVdc2 = _mm_or_si128(transparentVdc1, _mm_andnot_si128(vdc2Flags, _mm_srai_epi16(vdc1, 15)));
+				break;
+			}
+		}
+
+		__m128i color = _mm_or_si128(_mm_and_si128(showVdc2, vdc2), _mm_andnot_si128(showVdc2, vdc1));
+		_mm_storeu_si128((__m128i*)(out + i), color);
+	}
+#endif
+
+	for(; i < end; i++) {
+		out[i] = IsVdc2PixelVisible<mode>(rowBuffer[i], rowBufferVdc2[i]) ? rowBufferVdc2[i] : rowBuffer[i];
+	}
+}
+
 void PceVpc::ProcessScanline()
 {
 	uint16_t scanline = _vdc1->GetScanline();
@@ -198,64 +269,43 @@ void PceVpc::ProcessScanline()
 	uint16_t xMax = std::min<uint16_t>(pixelCount, _vdc1->GetHClock() / _vce->GetClockDivider());
 
 	//Supergrafx mode, merge outputs
-	uint32_t offset = (scanline - 14) * PceConstants::MaxScreenWidth;
+	uint16_t* out = _currentOutBuffer + (scanline - 14) * PceConstants::MaxScreenWidth;
 	uint16_t* rowBuffer = _vdc1->GetRowBuffer();
 	uint16_t* rowBufferVdc2 = _vdc2->GetRowBuffer();
 
 	uint16_t wnd1 = std::max(0, (int16_t)_state.Window1 - 16);
 	uint16_t wnd2 = std::max(0, (int16_t)_state.Window2 - 16);
-	for(uint32_t i = _xStart; i < xMax; i++) {
+
+	//The window (and its priority config) only changes at wnd1 and wnd2, mix each span between them in a single pass
+	for(uint32_t i = _xStart; i < xMax;) {
+		uint32_t end = xMax;
+		if(i < wnd1) {
+			end = std::min<uint32_t>(end, wnd1);
+		}
+		if(i < wnd2) {
+			end = std::min<uint32_t>(end, wnd2);
+		}
+
 		PceVpcPixelWindow wndType = (PceVpcPixelWindow)((i < wnd1) | ((i < wnd2) << 1));
 		PceVpcPriorityConfig& cfg = _state.WindowCfg[(int)wndType];
 		uint8_t enabledLayers = (uint8_t)cfg.Vdc1Enabled | ((uint8_t)cfg.Vdc2Enabled << 1);
-		uint16_t color;
 		switch(enabledLayers) {
 			default:
-			case 0: color = _vce->GetPalette(0); break;
-			case 1: color = rowBuffer[i]; break;
-			case 2: color = rowBufferVdc2[i]; break;
+			case 0: std::fill(out + i, out + end, _vce->GetPalette(0)); break;
+			case 1: memcpy(out + i, rowBuffer + i, (end - i) * sizeof(uint16_t)); break;
+			case 2: memcpy(out + i, rowBufferVdc2 + i, (end - i) * sizeof(uint16_t)); break;
 
 			case 3:
-			{
-				bool isSpriteVdc1 = (rowBuffer[i] & PceVpc::SpritePixelFlag) != 0;
-				bool isSpriteVdc2 = (rowBufferVdc2[i] & PceVpc::SpritePixelFlag) != 0;
-				bool isTransparentVdc1 = (rowBuffer[i] & PceVpc::TransparentPixelFlag) != 0;
-
 				switch(cfg.PriorityMode) {
 					default:
-					case PceVpcPriorityMode::Default:
-						color = isTransparentVdc1 ? rowBufferVdc2[i] : rowBuffer[i];
-						break;
-
-					case PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg:
-						//VDC2 sprites are shown above VDC1 background, but below VDC1 sprites
-						if(isTransparentVdc1 || (isSpriteVdc2 && !isSpriteVdc1)) {
-							//VDC1 transparent, show VDC2, or
-							//VDC2 is a sprite and VDC1 is not a sprite, show VDC2
-							color = rowBufferVdc2[i];
-						} else {
-							color = rowBuffer[i];
-						}
-						break;
-
-					case PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg: {
-						//VDC1 sprites are shown behind VDC2 background, but above VDC2 sprites(?)
-						bool isTransparentVdc2 = (rowBufferVdc2[i] & PceVpc::TransparentPixelFlag) != 0;
-						if(isTransparentVdc1 || (isSpriteVdc1 && !isSpriteVdc2 && !isTransparentVdc2)) {
-							//VDC1 transparent, show VDC2, or
-							//VDC1 is a sprite, show VDC2 (unless VDC2 is a transparent color or the background layer)
-							color = rowBufferVdc2[i];
-						} else {
-							color = rowBuffer[i];
-						}
-						break;
-					}
+					case PceVpcPriorityMode::Default: MixLayers<PceVpcPriorityMode::Default>(out, rowBuffer, rowBufferVdc2, i, end); break;
+					case PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg: MixLayers<PceVpcPriorityMode::Vdc2SpritesAboveVdc1Bg>(out, rowBuffer, rowBufferVdc2, i, end); break;
+					case PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg: MixLayers<PceVpcPriorityMode::Vdc1SpritesBelowVdc2Bg>(out, rowBuffer, rowBufferVdc2, i, end); break;
 				}
 				break;
-			}
 		}
 
-		_currentOutBuffer[offset + i] = color;
+		i = end;
 	}
 
 	_xStart = xMax;
@@ -34,6 +34,9 @@ private:
 	void SetPriorityConfig(PceVpcPixelWindow wnd, uint8_t value);
 	void UpdateIrqState();
 
+	template<PceVpcPriorityMode mode>
+	static void MixLayers(uint16_t* out, uint16_t* rowBuffer, uint16_t* rowBufferVdc2, uint32_t start, uint32_t end);
+
 public:
 	PceVpc(Emulator* emu, PceConsole* console, PceVce* vce);
 	~PceVpc();
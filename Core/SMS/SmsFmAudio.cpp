@@ -29,14 +29,20 @@ SmsFmAudio::~SmsFmAudio()
 void SmsFmAudio::Run()
 {
 	if(_fmEnabled && _emu->GetSettings()->GetSmsConfig().EnableFmAudio) {
-		uint64_t clocksToRun = _console->GetMasterClock() - _prevMasterClock;
-		while(clocksToRun >= 72) {
-			int16_t output = OPLL_calc(_opll);
-			_samplesToPlay.push_back(output);
-			_samplesToPlay.push_back(output);
-			_prevMasterClock += 72;
-			clocksToRun -= 72;
+		uint32_t sampleCount = (uint32_t)((_console->GetMasterClock() - _prevMasterClock) / 72);
+		if(sampleCount == 0) {
+			return;
 		}
+
+		//Render all samples up to the current clock in a single block
+		size_t pos = _samplesToPlay.size();
+		_samplesToPlay.resize(pos + sampleCount * 2);
+		int16_t* out = _samplesToPlay.data() + pos;
+		OPLL_calcBlock(_opll, out, sampleCount, 2);
+		for(uint32_t i = 0; i < sampleCount * 2; i += 2) {
+			out[i + 1] = out[i];
+		}
+		_prevMasterClock += sampleCount * 72;
 	} else {
 		_prevMasterClock = _console->GetMasterClock();
 	}
@@ -60,9 +60,43 @@ void SmsPsg::RunNoise(SmsNoiseChannelState& noise)
 void SmsPsg::Run()
 {
 	uint64_t runTo = _console->GetMasterClock();
+	if(_masterClock + 16 >= runTo) {
+		return;
+	}
+
 	uint32_t* volumes = _console->GetModel() == SmsModel::ColecoVision ? _settings->GetCvConfig().ChannelVolumes : _settings->GetSmsConfig().ChannelVolumes;
 
-	while(_masterClock + 16 < runTo) {
+	//Volumes can't change until the next write, calculate each channel's output level once
+	int16_t channelVolumes[4];
+	for(int i = 0; i < 3; i++) {
+		channelVolumes[i] = _volumeLut[_state.Tone[i].Volume] * volumes[i] / 100;
+	}
+	channelVolumes[3] = _volumeLut[_state.Noise.Volume] * volumes[3] / 100;
+
+	uint64_t stepsToRun = (runTo - _masterClock - 1) / 16;
+	bool firstStep = true;
+	while(stepsToRun > 0) {
+		if(!firstStep) {
+			//Until a timer expires, no channel output can change - skip directly to the next step where one does
+			//(the first step is always run normally since the last write may have changed the output)
+			uint32_t steps = GetStepsToNextToggle();
+			if(steps > stepsToRun) {
+				steps = (uint32_t)stepsToRun;
+			}
+
+			if(steps > 1) {
+				uint32_t skipped = steps - 1;
+				for(int i = 0; i < 3; i++) {
+					_state.Tone[i].Timer -= skipped;
+				}
+				_state.Noise.Timer -= skipped;
+				_clockCounter += skipped * 16;
+				_masterClock += skipped * 16;
+				stepsToRun -= skipped;
+			}
+		}
+		firstStep = false;
+
 		int16_t outputLeft = 0;
 		int16_t outputRight = 0;
 		int16_t channelOutput;
@@ -72,7 +106,7 @@ void SmsPsg::Run()
 				_state.Tone[i].Timer = _state.Tone[i].ReloadValue;
 			}
 
-			channelOutput = _state.Tone[i].Output * _volumeLut[_state.Tone[i].Volume] * volumes[i] / 100;
+			channelOutput = _state.Tone[i].Output ? channelVolumes[i] : 0;
 			if(_state.GameGearPanningReg & (0x01 << i)) {
 				outputRight += channelOutput;
 			}
@@ -82,7 +116,7 @@ void SmsPsg::Run()
 		}
 
 		RunNoise(_state.Noise);
-		channelOutput = _state.Noise.Output * _volumeLut[_state.Noise.Volume] * volumes[3] / 100;
+		channelOutput = _state.Noise.Output ? channelVolumes[3] : 0;
 		if(_state.GameGearPanningReg & 0x08) {
 			outputRight += channelOutput;
 		}
@@ -92,6 +126,7 @@ void SmsPsg::Run()
 
 		_clockCounter += 16;
 		_masterClock += 16;
+		stepsToRun--;
 
 		if(_prevOutputLeft != outputLeft || _prevOutputRight != outputRight) {
 			blip_add_delta(_leftChannel, _clockCounter, outputLeft - _prevOutputLeft);
@@ -106,6 +141,19 @@ void SmsPsg::Run()
 	}
 }
 
+uint32_t SmsPsg::GetStepsToNextToggle()
+{
+	//A timer at 0 expires on the next step, otherwise it expires once it has been decremented down to 0
+	uint32_t steps = _state.Noise.Timer == 0 ? 1 : _state.Noise.Timer;
+	for(int i = 0; i < 3; i++) {
+		uint32_t toneSteps = _state.Tone[i].Timer == 0 ? 1 : _state.Tone[i].Timer;
+		if(toneSteps < steps) {
+			steps = toneSteps;
+		}
+	}
+	return steps;
+}
+
 void SmsPsg::PlayQueuedAudio()
 {
 	blip_end_frame(_leftChannel, _clockCounter);
@@ -29,6 +29,7 @@ private:
 	int16_t _prevOutputRight = 0;
 
 	void RunNoise(SmsNoiseChannelState& noise);
+	uint32_t GetStepsToNextToggle();
 
 public:
 	SmsPsg(Emulator* emu, SmsConsole* console);
@@ -83,11 +83,49 @@ void SmsVdp::Run(uint64_t runTo)
 {
 	do {
 		//Always need to run at least once, check condition at the end of the loop (slightly faster)
-		Exec();
+		if(_state.Cycle == 0) {
+			_scanlineDeferred = CanDeferScanline();
+		}
+
+		if(_scanlineDeferred && _state.Cycle < 256 + SmsVdp::SmsVdpLeftBorder) {
+			//The scanline is drawn in a single pass at the end of the active display, unless the CPU accesses the VDP before that
+			_state.Cycle++;
+		} else {
+			if(_scanlineDeferred) {
+				DrawScanline();
+			}
+			Exec();
+		}
 		_lastMasterClock += 2;
 	} while(_lastMasterClock < runTo - 1);
 }
 
+bool SmsVdp::CanDeferScanline()
+{
+	//Only visible scanlines with no pending CPU VRAM access can be drawn in a single pass
+	//Any VDP port access while the scanline is deferred runs the skipped cycles first (see SyncScanline)
+	return (
+		_state.RenderingEnabled &&
+		_state.Scanline < _state.VisibleScanlineCount &&
+		_writePending == SmsVdpWriteType::None &&
+		!_readPending &&
+		!_disableBackground &&
+		!_emu->IsDebugging()
+	);
+}
+
+void SmsVdp::RunDeferredCycles()
+{
+	//Nothing that affects rendering can change while the scanline is deferred, so replaying
+	//the skipped cycles now produces the same result as running them at the time
+	_scanlineDeferred = false;
+	uint16_t cycle = _state.Cycle;
+	_state.Cycle = 0;
+	while(_state.Cycle < cycle) {
+		Exec();
+	}
+}
+
 void SmsVdp::UpdateConfig()
 {
 	bool useSgPalette = _model == SmsModel::ColecoVision || (_model == SmsModel::Sg && _emu->GetSettings()->GetSmsConfig().UseSgPalette);
@@ -349,30 +387,62 @@ int SmsVdp::GetVisiblePixelIndex()
 	return _state.Cycle - SmsVdp::SmsVdpLeftBorder;
 }
 
+uint16_t SmsVdp::GetSmsBgRow(uint16_t cycle)
+{
+	return cycle >= 192 && _state.VerticalScrollLock ? _state.Scanline : _bgOffsetY;
+}
+
+uint16_t SmsVdp::GetSmsNametableAddr(uint16_t cycle, uint16_t y)
+{
+	uint8_t x;
+	if(_state.Scanline < 16 && _state.HorizontalScrollLock) {
+		x = cycle;
+	} else {
+		x = (uint8_t)(cycle - (_state.HorizontalScrollLatch & 0xF8));
+	}
+
+	return (_state.EffectiveNametableAddress + ((x / 8) + (y / 8) * 32) * 2) & _state.NametableAddressMask;
+}
+
+void SmsVdp::SetSmsBgTile(uint16_t ntData, uint16_t y)
+{
+	bool vMirror = ntData & 0x400;
+	uint16_t tileIndex = ntData & 0x1FF;
+	uint8_t tileRow = vMirror ? 7 - (y & 0x07) : (y & 0x07);
+
+	_bgTileAddr = tileIndex * 32 + tileRow * 4;
+	_bgHorizontalMirror = (ntData & 0x200);
+}
+
+uint16_t SmsVdp::GetSmsBgTileAddr(bool highPlanes)
+{
+	if(_revision == SmsRevision::Sms1) {
+		if(highPlanes) {
+			return (_bgTileAddr & _state.BgPatternTableAddress) | (_bgTileAddr & 0x7FF);
+		} else {
+			return (_bgTileAddr & _state.ColorTableAddress) | (_bgTileAddr & 0x3F);
+		}
+	}
+	return _bgTileAddr;
+}
+
+uint8_t SmsVdp::GetSmsBgTileData(uint8_t value)
+{
+	return _bgHorizontalMirror ? ReverseBitOrder(value) : value;
+}
+
 void SmsVdp::LoadBgTilesSms()
 {
 	uint16_t cycle = _state.Cycle;
 	switch(cycle & 0x07) {
 		case 0: {
-			uint8_t x;
-			if(_state.Scanline < 16 && _state.HorizontalScrollLock) {
-				x = cycle;
-			} else {
-				x = (uint8_t)(cycle - (_state.HorizontalScrollLatch & 0xF8));
-			}
-
-			uint16_t y = cycle >= 192 && _state.VerticalScrollLock ? _state.Scanline : _bgOffsetY;
-			uint16_t ntAddr = (_state.EffectiveNametableAddress + ((x / 8) + (y / 8) * 32) * 2) & _state.NametableAddressMask;
+			uint16_t y = GetSmsBgRow(cycle);
+			uint16_t ntAddr = GetSmsNametableAddr(cycle, y);
 			uint16_t ntData = ReadVram(ntAddr, SmsVdpMemAccess::BgLoadTable) | (ReadVram(ntAddr + 1, SmsVdpMemAccess::BgLoadTable) << 8);
 
-			bool vMirror = ntData & 0x400;
-			uint16_t tileIndex = ntData & 0x1FF;
-			uint8_t tileRow = vMirror ? 7 - (y & 0x07) : (y & 0x07);
-
 			_bgPriority |= ((ntData & 0x1000) ? 0xFF : 0) << (16 - _pixelsAvailable);
 			_bgPalette |= ((ntData & 0x800) ? 0xFF : 0) << (16 - _pixelsAvailable);
-			_bgTileAddr = tileIndex * 32 + tileRow * 4;
-			_bgHorizontalMirror = (ntData & 0x200);
+			SetSmsBgTile(ntData, y);
 			break;
 		}
 
@@ -384,26 +454,16 @@ void SmsVdp::LoadBgTilesSms()
 			break;
 
 		case 4: {
-			uint16_t addr = _revision == SmsRevision::Sms1 ? ((_bgTileAddr & _state.ColorTableAddress) | (_bgTileAddr & 0x3F)) : _bgTileAddr;
-			if(_bgHorizontalMirror) {
-				_bgShifters[0] |= ReverseBitOrder(ReadVram(addr, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
-				_bgShifters[1] |= ReverseBitOrder(ReadVram(addr+1, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
-			} else {
-				_bgShifters[0] |= ReadVram(addr, SmsVdpMemAccess::BgLoadTile) << (16 - _pixelsAvailable);
-				_bgShifters[1] |= ReadVram(addr+1, SmsVdpMemAccess::BgLoadTile) << (16 - _pixelsAvailable);
-			}
+			uint16_t addr = GetSmsBgTileAddr(false);
+			_bgShifters[0] |= GetSmsBgTileData(ReadVram(addr, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
+			_bgShifters[1] |= GetSmsBgTileData(ReadVram(addr+1, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
 			break;
 		}
 
 		case 6: {
-			uint16_t addr = _revision == SmsRevision::Sms1 ? ((_bgTileAddr & _state.BgPatternTableAddress) | (_bgTileAddr & 0x7FF)) : _bgTileAddr;
-			if(_bgHorizontalMirror) {
-				_bgShifters[2] |= ReverseBitOrder(ReadVram(addr+2, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
-				_bgShifters[3] |= ReverseBitOrder(ReadVram(addr+3, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
-			} else {
-				_bgShifters[2] |= ReadVram(addr+2, SmsVdpMemAccess::BgLoadTile) << (16 - _pixelsAvailable);
-				_bgShifters[3] |= ReadVram(addr+3, SmsVdpMemAccess::BgLoadTile) << (16 - _pixelsAvailable);
-			}
+			uint16_t addr = GetSmsBgTileAddr(true);
+			_bgShifters[2] |= GetSmsBgTileData(ReadVram(addr+2, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
+			_bgShifters[3] |= GetSmsBgTileData(ReadVram(addr+3, SmsVdpMemAccess::BgLoadTile)) << (16 - _pixelsAvailable);
 
 			if(_disableBackground) {
 				memset(_bgShifters, 0, sizeof(_bgShifters));
@@ -416,6 +476,72 @@ void SmsVdp::LoadBgTilesSms()
 	}
 }
 
+uint16_t SmsVdp::GetSgNametableAddr(uint16_t cycle)
+{
+	uint8_t x = (uint8_t)cycle;
+	uint8_t tilemapRow = (_state.Scanline / 8);
+	if(_state.M1_Use224LineMode) {
+		//Text mode - 40 columns of 6 pixels
+		return _state.NametableAddress + ((x / 6) + tilemapRow * 40);
+	}
+	return _state.NametableAddress + ((x / 8) + tilemapRow * 32);
+}
+
+void SmsVdp::SetSgBgTile(uint8_t tileIndex)
+{
+	uint8_t tilemapRow = (_state.Scanline / 8);
+	uint8_t tileRow = (_state.Scanline & 0x07);
+	_bgTileIndex = tileIndex;
+	if(_state.M1_Use224LineMode) {
+		//Text mode - same pattern table layout as Graphic 1
+		_bgTileAddr = (_state.BgPatternTableAddress & 0x3800) + (_bgTileIndex * 8) + tileRow;
+	} else if(_state.M3_Use240LineMode) {
+		//Mode 3 - "Multicolor"
+		_bgTileAddr = (_state.BgPatternTableAddress & 0x3800) + (_bgTileIndex * 8) + (tilemapRow & 0x03) * 2 + (tileRow >= 4 ? 1 : 0);
+	} else if(_state.M2_AllowHeightChange) {
+		//Mode 2 - "Graphic 2"
+		//Move to the next 256 tiles after every 8 tile rows
+		_bgTileIndex += (tilemapRow & 0x18) << 5;
+		uint16_t mask = ((_state.BgPatternTableAddress >> 3) | 0xFF) & 0x3FF;
+		_bgTileAddr = (_state.BgPatternTableAddress & 0x2000) + ((_bgTileIndex & mask) * 8) + tileRow;
+	} else {
+		//Mode 0 - "Graphic 1"
+		_bgTileAddr = (_state.BgPatternTableAddress & 0x3800) + (_bgTileIndex * 8) + tileRow;
+	}
+}
+
+uint16_t SmsVdp::GetSgColorTableAddr()
+{
+	if(_state.M2_AllowHeightChange) {
+		//Mode 2 - "Graphic 2"
+		uint16_t mask = ((_state.ColorTableAddress >> 3) | 0x07) & 0x3FF;
+		uint8_t tileRow = (_state.Scanline & 0x07);
+		return (_state.ColorTableAddress & 0x2000) | (((_bgTileIndex & mask) << 3) + tileRow);
+	} else {
+		//Mode 0 - "Graphic 1"
+		return (_state.ColorTableAddress & 0x3FC0) | ((_bgTileIndex >> 3) & 0x1F);
+	}
+}
+
+uint8_t SmsVdp::GetNextSgPixelColor(uint8_t color, int index)
+{
+	uint8_t pixelColor;
+	if(_state.M3_Use240LineMode) {
+		pixelColor = index < 4 ? (color >> 4) : (color & 0xF);
+	} else {
+		pixelColor = (_bgPatternData & 0x80) ? (color >> 4) : (color & 0xF);
+	}
+	_bgPatternData <<= 1;
+	return pixelColor;
+}
+
+uint8_t SmsVdp::GetNextTextModePixelColor()
+{
+	uint8_t color = (_bgPatternData & 0x80) ? _state.TextColorIndex : _state.BackgroundColorIndex;
+	_bgPatternData <<= 1;
+	return color;
+}
+
 void SmsVdp::LoadBgTilesSg()
 {
 	if(_state.M1_Use224LineMode) {
@@ -425,29 +551,9 @@ void SmsVdp::LoadBgTilesSg()
 
 	uint16_t cycle = _state.Cycle;
 	switch(cycle & 0x07) {
-		case 0: {
-			uint8_t x = (uint8_t)_state.Cycle;
-			uint16_t y = _state.Scanline;
-			uint8_t tilemapRow = (y / 8);
-			uint16_t ntAddr = _state.NametableAddress + ((x / 8) + tilemapRow * 32);
-
-			uint8_t tileRow = (y & 0x07);
-			_bgTileIndex = ReadVram(ntAddr, SmsVdpMemAccess::BgLoadTable);
-			if(_state.M3_Use240LineMode) {
-				//Mode 3 - "Multicolor"
-				_bgTileAddr = (_state.BgPatternTableAddress & 0x3800) + (_bgTileIndex * 8) + (tilemapRow & 0x03) * 2 + (tileRow >= 4 ? 1 : 0);
-			} else if(_state.M2_AllowHeightChange) {
-				//Mode 2 - "Graphic 2"
-				//Move to the next 256 tiles after every 8 tile rows
-				_bgTileIndex += (tilemapRow & 0x18) << 5;
-				uint16_t mask = ((_state.BgPatternTableAddress >> 3) | 0xFF) & 0x3FF;
-				_bgTileAddr = (_state.BgPatternTableAddress & 0x2000) + ((_bgTileIndex & mask) * 8) + tileRow;
-			} else {
-				//Mode 0 - "Graphic 1"
-				_bgTileAddr = (_state.BgPatternTableAddress & 0x3800) + (_bgTileIndex * 8) + tileRow;
-			}
+		case 0:
+			SetSgBgTile(ReadVram(GetSgNametableAddr(cycle), SmsVdpMemAccess::BgLoadTable));
 			break;
-		}
 
 		case 2:
 			if(cycle & 0x18) {
@@ -465,27 +571,12 @@ void SmsVdp::LoadBgTilesSg()
 			if(_state.M3_Use240LineMode) {
 				//Mode 3 - "Multicolor"
 				color = _bgPatternData;
-			} else if(_state.M2_AllowHeightChange) {
-				//Mode 2 - "Graphic 2"
-				uint16_t mask = ((_state.ColorTableAddress >> 3) | 0x07) & 0x3FF;
-				uint8_t tileRow = (_state.Scanline & 0x07);
-				uint16_t colorTableAddr = (_state.ColorTableAddress & 0x2000) | ((_bgTileIndex & mask) << 3) + tileRow;
-				color = ReadVram(colorTableAddr, SmsVdpMemAccess::BgLoadTile);
 			} else {
-				//Mode 0 - "Graphic 1"
-				uint16_t colorTableAddr = (_state.ColorTableAddress & 0x3FC0) | ((_bgTileIndex >> 3) & 0x1F);
-				color = ReadVram(colorTableAddr, SmsVdpMemAccess::BgLoadTable);
+				color = ReadVram(GetSgColorTableAddr(), _state.M2_AllowHeightChange ? SmsVdpMemAccess::BgLoadTile : SmsVdpMemAccess::BgLoadTable);
 			}
 
 			for(int i = 0; i < 8; i++) {
-				uint8_t pixelColor;
-				if(_state.M3_Use240LineMode) {
-					pixelColor = i < 4 ? (color >> 4) : (color & 0xF);
-				} else {
-					pixelColor = (_bgPatternData & 0x80) ? (color >> 4) : (color & 0xF);
-				}
-				_bgPatternData <<= 1;
-				PushBgPixel(pixelColor, i);
+				PushBgPixel(GetNextSgPixelColor(color, i), i);
 			}
 
 			if(_disableBackground) {
@@ -502,30 +593,28 @@ void SmsVdp::LoadBgTilesSg()
 void SmsVdp::LoadBgTilesSgTextMode()
 {
 	if(_state.Cycle >= 240) {
+		if(_state.Cycle == 240) {
+			//Add 8 pixels of border on the right after the last column (the shifters have room for them once the first 232 pixels are drawn)
+			for(int i = 0; i < 8; i++) {
+				PushBgPixel(_state.BackgroundColorIndex, i);
+			}
+			_pixelsAvailable += 8;
+		}
 		return;
 	} else if(_state.Cycle == 0) {
 		_textModeStep = 0;
 	}
 
 	switch(_textModeStep++) {
-		case 0: {
-			uint8_t x = (uint8_t)_state.Cycle;
-			uint16_t y = _state.Scanline;
-			uint8_t tilemapRow = (y / 8);
-			uint16_t ntAddr = _state.NametableAddress + ((x / 6) + tilemapRow * 40);
-			uint8_t tileRow = (y & 0x07);
-			_bgTileIndex = ReadVram(ntAddr, SmsVdpMemAccess::BgLoadTable);
-			_bgTileAddr = (_state.BgPatternTableAddress & 0x3800) + (_bgTileIndex * 8) + tileRow;
+		case 0:
+			SetSgBgTile(ReadVram(GetSgNametableAddr(_state.Cycle), SmsVdpMemAccess::BgLoadTable));
 			break;
-		}
 
 		case 2:
 			_bgPatternData = ReadVram(_bgTileAddr, SmsVdpMemAccess::BgLoadTile);
 
 			for(int i = 0; i < 6; i++) {
-				uint8_t color = (_bgPatternData & 0x80) ? _state.TextColorIndex : _state.BackgroundColorIndex;
-				_bgPatternData <<= 1;
-				PushBgPixel(color, i);
+				PushBgPixel(GetNextTextModePixelColor(), i);
 			}
 
 			if(_disableBackground) {
@@ -533,13 +622,6 @@ void SmsVdp::LoadBgTilesSgTextMode()
 				_bgPriority = 0;
 			}
 
-			if(_state.Cycle == 238) {
-				for(int i = 0; i < 8; i++) {
-					PushBgPixel(_state.BackgroundColorIndex, i);
-				}
-				_pixelsAvailable += 8;
-			}
-
 			_pixelsAvailable += 6;
 			break;
 
@@ -1071,6 +1153,70 @@ bool SmsVdp::IsZoomedSpriteAllowed(int spriteIndex)
 	return _state.EnableDoubleSpriteSize && (!_state.UseMode4 || spriteIndex < ((int)_spriteCount - 4) || _revision != SmsRevision::Sms1);
 }
 
+uint8_t SmsVdp::GetNextSpritePixel(int spriteIndex, int xPos)
+{
+	SpriteShifter& spr = _spriteShifters[spriteIndex];
+	if(_state.UseMode4) {
+		uint8_t sprColor = (
+			((spr.TileData[0] >> 7) & 0x01) |
+			((spr.TileData[1] >> 6) & 0x02) |
+			((spr.TileData[2] >> 5) & 0x04) |
+			((spr.TileData[3] >> 4) & 0x08)
+		);
+
+		if(!IsZoomedSpriteAllowed(spriteIndex) || ((spr.SpriteX - xPos) & 0x01)) {
+			spr.TileData[0] <<= 1;
+			spr.TileData[1] <<= 1;
+			spr.TileData[2] <<= 1;
+			spr.TileData[3] <<= 1;
+		}
+		return sprColor;
+	} else {
+		uint8_t sprColor = ((spr.TileData[0] >> 7) & 0x01);
+		if(!_state.EnableDoubleSpriteSize || ((spr.SpriteX - xPos) & 0x01)) {
+			spr.TileData[0] <<= 1;
+		}
+		return sprColor;
+	}
+}
+
+void SmsVdp::MergeSpritePixel(int spriteIndex, uint8_t sprColor, bool& spriteDrawn, uint8_t& spritePixelColor)
+{
+	if(sprColor == 0) {
+		return;
+	}
+
+	if(spriteDrawn) {
+		_state.SpriteCollision |= _spriteShifters[spriteIndex].HardwareSprite;
+	} else if(_state.UseMode4) {
+		spritePixelColor = sprColor;
+		spriteDrawn = true;
+	} else {
+		uint8_t spritePalette = _spriteShifters[spriteIndex].TileData[1];
+		if(spritePalette != 0) {
+			spritePixelColor = spritePalette;
+			spriteDrawn = true;
+		}
+	}
+}
+
+uint16_t SmsVdp::GetOutputColor(uint8_t bgColor, bool bgHighPriority, bool bgPalette, bool spriteDrawn, uint8_t spritePixelColor)
+{
+	if(!spriteDrawn || (bgHighPriority && bgColor != 0) || _disableSprites) {
+		if(_state.UseMode4) {
+			return _internalPaletteRam[(bgPalette ? 0x10 : 0) + bgColor];
+		} else {
+			return _activeSgPalette[bgColor == 0 ? _state.BackgroundColorIndex : bgColor];
+		}
+	}
+
+	if(_state.UseMode4) {
+		return _internalPaletteRam[0x10 + spritePixelColor];
+	} else {
+		return _activeSgPalette[spritePixelColor];
+	}
+}
+
 uint16_t SmsVdp::GetPixelColor()
 {
 	if(!_state.RenderingEnabled || _state.Cycle < SmsVdp::SmsVdpLeftBorder) {
@@ -1082,49 +1228,7 @@ uint16_t SmsVdp::GetPixelColor()
 	uint16_t xPos = GetVisiblePixelIndex();
 	for(int i = 0; i < _spriteCount; i++) {
 		if(xPos >= _spriteShifters[i].SpriteX && xPos < _spriteShifters[i].SpriteX + (8 << (uint8_t)IsZoomedSpriteAllowed(i))) {
-			if(_state.UseMode4) {
-				uint8_t sprColor = (
-					((_spriteShifters[i].TileData[0] >> 7) & 0x01) |
-					((_spriteShifters[i].TileData[1] >> 6) & 0x02) |
-					((_spriteShifters[i].TileData[2] >> 5) & 0x04) |
-					((_spriteShifters[i].TileData[3] >> 4) & 0x08)
-				);
-
-				if(!IsZoomedSpriteAllowed(i) || ((_spriteShifters[i].SpriteX - xPos) & 0x01)) {
-					_spriteShifters[i].TileData[0] <<= 1;
-					_spriteShifters[i].TileData[1] <<= 1;
-					_spriteShifters[i].TileData[2] <<= 1;
-					_spriteShifters[i].TileData[3] <<= 1;
-				}
-
-				if(sprColor != 0) {
-					if(spriteDrawn) {
-						_state.SpriteCollision |= _spriteShifters[i].HardwareSprite;
-						continue;
-					} else {
-						spritePixelColor = sprColor;
-						spriteDrawn = true;
-					}
-				}
-			} else {
-				uint8_t sprColor = ((_spriteShifters[i].TileData[0] >> 7) & 0x01);
-				if(!_state.EnableDoubleSpriteSize || ((_spriteShifters[i].SpriteX - xPos) & 0x01)) {
-					_spriteShifters[i].TileData[0] <<= 1;
-				}
-
-				if(sprColor != 0) {
-					if(spriteDrawn) {
-						_state.SpriteCollision |= _spriteShifters[i].HardwareSprite;
-						continue;
-					} else {
-						uint8_t spritePalette = _spriteShifters[i].TileData[1];
-						if(spritePalette != 0) {
-							spritePixelColor = spritePalette;
-							spriteDrawn = true;
-						}
-					}
-				}
-			}
+			MergeSpritePixel(i, GetNextSpritePixel(i, xPos), spriteDrawn, spritePixelColor);
 		}
 	}
 
@@ -1139,21 +1243,128 @@ uint16_t SmsVdp::GetPixelColor()
 		((_bgShifters[3] >> 20) & 0x08)
 	);
 
-	bool highPriority = (_bgPriority & 0x800000);
-	if(!spriteDrawn || (highPriority && color != 0) || _disableSprites) {
-		uint8_t paletteOffset = (_bgPalette & 0x800000) ? 0x10 : 0;
-		if(_state.UseMode4) {
-			return _internalPaletteRam[paletteOffset + color];
-		} else {
-			return _activeSgPalette[color == 0 ? _state.BackgroundColorIndex : color];
-		}
+	return GetOutputColor(color, _bgPriority & 0x800000, _bgPalette & 0x800000, spriteDrawn, spritePixelColor);
+}
+
+void SmsVdp::DrawScanline()
+{
+	//Produces the same result as running Exec() for cycles 0 to 263 of a visible scanline
+	//(rendering enabled, no CPU VRAM access pending and no VDP port access during these cycles)
+	_scanlineDeferred = false;
+	_needCramDot = false;
+
+	//Background pixels in the order the shifters output them: bits 0-3 = color, bit 4 = priority, bit 5 = palette
+	//Starts with the left border pixels that were pushed at the end of the previous scanline
+	uint8_t bgPixels[256 + 16] = {};
+	int pixelCount = _pixelsAvailable;
+	for(int i = 0; i < pixelCount; i++) {
+		bgPixels[i] = (
+			((_bgShifters[0] >> (23 - i)) & 0x01) |
+			(((_bgShifters[1] >> (23 - i)) & 0x01) << 1) |
+			(((_bgShifters[2] >> (23 - i)) & 0x01) << 2) |
+			(((_bgShifters[3] >> (23 - i)) & 0x01) << 3) |
+			(((_bgPriority >> (23 - i)) & 0x01) << 4) |
+			(((_bgPalette >> (23 - i)) & 0x01) << 5)
+		);
 	}
 
 	if(_state.UseMode4) {
-		return _internalPaletteRam[0x10 + spritePixelColor];
+		//Same fetches as LoadBgTilesSms
+		for(int cycle = 0; cycle < 256; cycle += 8) {
+			uint16_t y = GetSmsBgRow(cycle);
+			uint16_t ntAddr = GetSmsNametableAddr(cycle, y);
+			uint16_t ntData = _videoRam[ntAddr] | (_videoRam[ntAddr + 1] << 8);
+			uint8_t attributes = ((ntData & 0x1000) ? 0x10 : 0) | ((ntData & 0x800) ? 0x20 : 0);
+			SetSmsBgTile(ntData, y);
+
+			uint16_t lowAddr = GetSmsBgTileAddr(false);
+			uint16_t highAddr = GetSmsBgTileAddr(true);
+			uint8_t planes[4] = {
+				GetSmsBgTileData(_videoRam[lowAddr]),
+				GetSmsBgTileData(_videoRam[lowAddr + 1]),
+				GetSmsBgTileData(_videoRam[highAddr + 2]),
+				GetSmsBgTileData(_videoRam[highAddr + 3])
+			};
+
+			for(int i = 0; i < 8; i++) {
+				bgPixels[pixelCount++] = (
+					((planes[0] >> (7 - i)) & 0x01) |
+					(((planes[1] >> (7 - i)) & 0x01) << 1) |
+					(((planes[2] >> (7 - i)) & 0x01) << 2) |
+					(((planes[3] >> (7 - i)) & 0x01) << 3) |
+					attributes
+				);
+			}
+		}
+	} else if(_state.M1_Use224LineMode) {
+		//Same fetches as LoadBgTilesSgTextMode
+		for(int cycle = 0; cycle < 240; cycle += 6) {
+			SetSgBgTile(_videoRam[GetSgNametableAddr(cycle)]);
+			_bgPatternData = _videoRam[_bgTileAddr];
+
+			for(int i = 0; i < 6; i++) {
+				bgPixels[pixelCount++] = GetNextTextModePixelColor();
+			}
+		}
+
+		//Right border
+		for(int i = 0; i < 8; i++) {
+			bgPixels[pixelCount++] = _state.BackgroundColorIndex;
+		}
+		_textModeStep = 0;
 	} else {
-		return _activeSgPalette[spritePixelColor];
+		//Same fetches as LoadBgTilesSg
+		for(int cycle = 0; cycle < 256; cycle += 8) {
+			SetSgBgTile(_videoRam[GetSgNametableAddr(cycle)]);
+			_bgPatternData = _videoRam[_bgTileAddr];
+			uint8_t color = _state.M3_Use240LineMode ? _bgPatternData : _videoRam[GetSgColorTableAddr()];
+
+			for(int i = 0; i < 8; i++) {
+				bgPixels[pixelCount++] = GetNextSgPixelColor(color, i);
+			}
+		}
+	}
+
+	//Sprite evaluation for the next scanline runs during 24 of the BG fetch slots (2 sprites per slot in mode 4, none in text mode)
+	int evalCount = _state.UseMode4 ? 48 : (_state.M1_Use224LineMode ? 0 : 24);
+	for(int i = 0; i < evalCount; i++) {
+		ProcessSpriteEvaluation();
+	}
+
+	//Draw each sprite over the whole line, in priority order - same logic as GetPixelColor
+	uint8_t sprPixels[256] = {};
+	bool sprDrawn[256] = {};
+	for(int i = 0; i < _spriteCount; i++) {
+		int start = std::max<int>(0, _spriteShifters[i].SpriteX);
+		int end = std::min<int>(256, _spriteShifters[i].SpriteX + (8 << (uint8_t)IsZoomedSpriteAllowed(i)));
+		for(int xPos = start; xPos < end; xPos++) {
+			MergeSpritePixel(i, GetNextSpritePixel(i, xPos), sprDrawn[xPos], sprPixels[xPos]);
+		}
+	}
+
+	uint16_t* out = _currentOutputBuffer + _state.Scanline * 256;
+	for(int xPos = 0; xPos < 256; xPos++) {
+		if(xPos + SmsVdp::SmsVdpLeftBorder < _minDrawCycle) {
+			out[xPos] = _internalPaletteRam[0x10 | _state.BackgroundColorIndex];
+		} else {
+			out[xPos] = GetOutputColor(bgPixels[xPos] & 0x0F, bgPixels[xPos] & 0x10, bgPixels[xPos] & 0x20, sprDrawn[xPos], sprPixels[xPos]);
+		}
 	}
+
+	//Leave the shifters in the state the per-cycle renderer would have left them in (loaded pixels that were not drawn)
+	memset(_bgShifters, 0, sizeof(_bgShifters));
+	_bgPriority = 0;
+	_bgPalette = 0;
+	for(int i = 248; i < pixelCount; i++) {
+		int shift = 23 + 256 - i;
+		_bgShifters[0] |= (bgPixels[i] & 0x01) << shift;
+		_bgShifters[1] |= ((bgPixels[i] >> 1) & 0x01) << shift;
+		_bgShifters[2] |= ((bgPixels[i] >> 2) & 0x01) << shift;
+		_bgShifters[3] |= ((bgPixels[i] >> 3) & 0x01) << shift;
+		_bgPriority |= ((bgPixels[i] >> 4) & 0x01) << shift;
+		_bgPalette |= ((bgPixels[i] >> 5) & 0x01) << shift;
+	}
+	_pixelsAvailable = (uint8_t)(pixelCount - 256);
 }
 
 void SmsVdp::WriteRegister(uint8_t reg, uint8_t value)
@@ -1240,6 +1451,8 @@ void SmsVdp::WriteGameGearPalette(uint8_t addr, uint16_t value)
 
 void SmsVdp::WritePort(uint8_t port, uint8_t value)
 {
+	SyncScanline();
+
 	if(port & 1) {
 		//Control port
 		if(_state.ControlPortMsbToggle) {
@@ -1303,6 +1516,8 @@ uint8_t SmsVdp::ReadPort(uint8_t port)
 
 		case 0x80: {
 			//Data Port
+			SyncScanline();
+
 			//"Any subsequent data port read will return the value in the buffer.
 			//The value stored at the current VRAM location specified by the address
 			//register is then copied to the buffer, and the address register is incremented"
@@ -1315,6 +1530,9 @@ uint8_t SmsVdp::ReadPort(uint8_t port)
 
 		case 0x81: {
 			//Control Port
+			//Sprite collision flag is set while drawing the scanline
+			SyncScanline();
+
 			uint8_t value = (
 				(_state.VerticalBlankIrqPending ? 0x80 : 0) |
 				(_state.SpriteOverflow ? 0x40 : 0) |
@@ -1379,6 +1597,8 @@ void SmsVdp::LatchHorizontalCounter()
 
 void SmsVdp::SetRegion(ConsoleRegion region)
 {
+	SyncScanline();
+
 	if(region == ConsoleRegion::Pal) {
 		_scanlineCount = 313;
 	} else {
@@ -1389,6 +1609,8 @@ void SmsVdp::SetRegion(ConsoleRegion region)
 
 void SmsVdp::DebugSendFrame()
 {
+	SyncScanline();
+
 	int offset = std::max(0, std::min((int)GetVisiblePixelIndex(), 256)) + (_state.Scanline * 256);
 	int pixelsToClear = 256*240 - offset;
 	if(pixelsToClear > 0) {
@@ -1402,6 +1624,7 @@ void SmsVdp::DebugSendFrame()
 uint32_t SmsVdp::GetPixelBrightness(uint8_t x, uint8_t y)
 {
 	//Used by light phaser, gives a rough approximation of the brightness level of the specific pixel
+	SyncScanline();
 	uint32_t argbColor = ColorUtilities::Rgb555ToArgb(_currentOutputBuffer[y << 8 | x]);
 	return (argbColor & 0xFF) + ((argbColor >> 8) & 0xFF) + ((argbColor >> 16) & 0xFF);
 }
@@ -1470,6 +1693,12 @@ void SmsVdp::InitGgPowerOnState()
 
 void SmsVdp::Serialize(Serializer& s)
 {
+	if(s.IsSaving()) {
+		SyncScanline();
+	} else {
+		_scanlineDeferred = false;
+	}
+
 	SVArray(_videoRam, 0x4000);
 	SVArray(_paletteRam, 0x40);
 	SVArray(_internalPaletteRam, 0x20);
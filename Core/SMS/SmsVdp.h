@@ -62,6 +62,9 @@ private:
 	SmsVdpState _state = {};
 	uint64_t _lastMasterClock = 0;
 
+	//Set while the active display portion (cycles 0-263) of the current scanline is being skipped, to draw it in a single pass
+	bool _scanlineDeferred = false;
+
 	uint32_t _bgShifters[4] = {};
 	uint32_t _bgPriority = 0;
 	uint32_t _bgPalette = 0;
@@ -134,9 +137,31 @@ private:
 	void LoadBgTilesSg();
 	void LoadBgTilesSgTextMode();
 	void PushBgPixel(uint8_t color, int index);
+
+	//BG fetch/decode steps shared by the LoadBgTiles* functions and DrawScanline
+	__forceinline uint16_t GetSmsBgRow(uint16_t cycle);
+	__forceinline uint16_t GetSmsNametableAddr(uint16_t cycle, uint16_t y);
+	__forceinline void SetSmsBgTile(uint16_t ntData, uint16_t y);
+	__forceinline uint16_t GetSmsBgTileAddr(bool highPlanes);
+	__forceinline uint8_t GetSmsBgTileData(uint8_t value);
+	__forceinline uint16_t GetSgNametableAddr(uint16_t cycle);
+	__forceinline void SetSgBgTile(uint8_t tileIndex);
+	__forceinline uint16_t GetSgColorTableAddr();
+	__forceinline uint8_t GetNextSgPixelColor(uint8_t color, int index);
+	__forceinline uint8_t GetNextTextModePixelColor();
 	
 	__forceinline void DrawPixel();
 
+	bool CanDeferScanline();
+	void DrawScanline();
+	void RunDeferredCycles();
+	__forceinline void SyncScanline()
+	{
+		if(_scanlineDeferred) {
+			RunDeferredCycles();
+		}
+	}
+
 	void ProcessScanlineEvents();
 	void ProcessEndOfScanline();
 
@@ -146,6 +171,9 @@ private:
 	void LoadSpriteTilesSms();
 	void LoadExtraSpritesSms();
 	__forceinline uint16_t GetPixelColor();
+	__forceinline uint8_t GetNextSpritePixel(int spriteIndex, int xPos);
+	__forceinline void MergeSpritePixel(int spriteIndex, uint8_t sprColor, bool& spriteDrawn, uint8_t& spritePixelColor);
+	__forceinline uint16_t GetOutputColor(uint8_t bgColor, bool bgHighPriority, bool bgPalette, bool spriteDrawn, uint8_t spritePixelColor);
 
 	void LoadSpriteTilesSg();
 	void LoadExtraSpritesSg();
@@ -175,6 +175,11 @@ void DspVoice::ProcessEnvelope()
 
 void DspVoice::UpdateOutput(bool right)
 {
+	if(_shared->VoiceOutput == 0) {
+		//Silent voice, the output and echo samples are already within 16-bit range and would be unchanged
+		return;
+	}
+
 	//"Load and apply VxVOL[L/R] register."
 	int32_t voiceOut = ((int32_t)_shared->VoiceOutput * (int8_t)ReadReg((DspVoiceRegs)((int)DspVoiceRegs::VolLeft + (int)right))) >> 7;
 
@@ -261,17 +266,19 @@ void DspVoice::Step3c()
 	}
 
 	int32_t output = 0;
-	switch(_cfg->InterpolationType) {
-		case DspInterpolationType::Gauss: output = DspInterpolation::Gauss(_interpolationPos, _sampleBuffer, _bufferPos); break;
-		case DspInterpolationType::Cubic: output = DspInterpolation::Cubic(_interpolationPos, _sampleBuffer, _bufferPos); break;
-		case DspInterpolationType::Sinc: output = DspInterpolation::Sinc(_interpolationPos, _sampleBuffer, _bufferPos); break;
-		case DspInterpolationType::None: output = _sampleBuffer[((_interpolationPos >> 12) + _bufferPos) % 12]; break;
-	}
-
-	//"If applicable, replace the current sample with the noise sample."
-	if(_shared->NoiseOn & _voiceBit) {
+	if(_envVolume == 0) {
+		//The envelope silences the voice, the sample's value doesn't matter (output is always 0)
+	} else if(_shared->NoiseOn & _voiceBit) {
+		//"If applicable, replace the current sample with the noise sample."
 		//"And the output noise sample at any point is N (after which is volume adjustment then the left - shift to 'restore' the low bit)"
 		output = (int16_t)(_shared->NoiseLfsr * 2);
+	} else {
+		switch(_cfg->InterpolationType) {
+			case DspInterpolationType::Gauss: output = DspInterpolation::Gauss(_interpolationPos, _sampleBuffer, _bufferPos); break;
+			case DspInterpolationType::Cubic: output = DspInterpolation::Cubic(_interpolationPos, _sampleBuffer, _bufferPos); break;
+			case DspInterpolationType::Sinc: output = DspInterpolation::Sinc(_interpolationPos, _sampleBuffer, _bufferPos); break;
+			case DspInterpolationType::None: output = _sampleBuffer[((_interpolationPos >> 12) + _bufferPos) % 12]; break;
+		}
 	}
 
 	//"Apply the volume envelope. - This is the value used for modulating the next voice's pitch, if applicable."
@@ -26,4 +26,8 @@ public:
 	}
 
 	virtual AddressInfo GetAbsoluteAddress(uint32_t address) = 0;
+
+	//Pointer to the 4 KB page, when accesses are plain memory reads/writes with no side effects (nullptr otherwise)
+	virtual uint8_t* GetDirectReadPage() { return nullptr; }
+	virtual uint8_t* GetDirectWritePage() { return nullptr; }
 };
\ No newline at end of file
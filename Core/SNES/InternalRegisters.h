@@ -56,6 +56,8 @@ public:
 	void ProcessAutoJoypad();
 
 	__forceinline void ProcessIrqCounters();
+	__forceinline bool CanBatchIrqCounters();
+	__forceinline void ProcessIrqCounters(uint16_t tickCount);
 
 	uint8_t GetIoPortOutput();
 	void SetNmiFlag(bool nmiFlag);
@@ -159,4 +161,20 @@ void InternalRegisters::ProcessIrqCounters()
 	}
 
 	UpdateIrqLevel();
-}
\ No newline at end of file
+}
+
+bool InternalRegisters::CanBatchIrqCounters()
+{
+	//When no IRQ is pending and the IRQ level can't change, ticks past H=10 only increment the H counter
+	if(_needIrq) {
+		return false;
+	}
+	return !_irqEnabled || (!_state.EnableHorizontalIrq && _irqLevel == (_state.VerticalTimer == _vCounter));
+}
+
+void InternalRegisters::ProcessIrqCounters(uint16_t tickCount)
+{
+	//Equivalent to calling ProcessIrqCounters() tickCount times, only valid when CanBatchIrqCounters() is true
+	_hCounter += tickCount;
+	UpdateIrqLevel();
+}
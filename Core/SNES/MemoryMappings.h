@@ -9,11 +9,20 @@ class MemoryMappings
 private:
 	IMemoryHandler* _handlers[0x100 * 0x10] = {};
 
+	//Direct pointers for pages backed by plain RAM/ROM (nullptr for I/O, mirrored or special pages)
+	uint8_t* _readPages[0x100 * 0x10] = {};
+	uint8_t* _writePages[0x100 * 0x10] = {};
+
+	void SetHandler(uint32_t page, IMemoryHandler* handler);
+
 public:
 	void RegisterHandler(uint8_t startBank, uint8_t endBank, uint16_t startPage, uint16_t endPage, vector<unique_ptr<IMemoryHandler>>& handlers, uint16_t pageIncrement = 0, uint16_t startPageNumber = 0);
 	void RegisterHandler(uint8_t startBank, uint8_t endBank, uint16_t startAddr, uint16_t endAddr, IMemoryHandler* handler);
 
-	IMemoryHandler* GetHandler(uint32_t addr);
+	__forceinline IMemoryHandler* GetHandler(uint32_t addr) { return _handlers[addr >> 12]; }
+	__forceinline uint8_t* GetReadPage(uint32_t addr) { return _readPages[addr >> 12]; }
+	__forceinline uint8_t* GetWritePage(uint32_t addr) { return _writePages[addr >> 12]; }
+
 	AddressInfo GetAbsoluteAddress(uint32_t addr);
 	int GetRelativeAddress(AddressInfo& absAddress, uint8_t startBank = 0);
 
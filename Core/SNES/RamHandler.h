@@ -54,6 +54,17 @@ public:
 
 	uint32_t GetOffset() { return _offset; }
 
+	uint8_t* GetDirectReadPage() override
+	{
+		//Pages smaller than 4 KB are mirrored and need the mask
+		return _mask == 0xFFF ? _ram : nullptr;
+	}
+
+	uint8_t* GetDirectWritePage() override
+	{
+		return _mask == 0xFFF ? _ram : nullptr;
+	}
+
 	AddressInfo GetAbsoluteAddress(uint32_t address) override
 	{
 		AddressInfo info;
@@ -10,4 +10,9 @@ public:
 	void Write(uint32_t addr, uint8_t value) override
 	{
 	}
+
+	uint8_t* GetDirectWritePage() override
+	{
+		return nullptr;
+	}
 };
\ No newline at end of file
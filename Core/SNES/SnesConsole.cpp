@@ -72,6 +72,7 @@ void SnesConsole::RunFrame()
 void SnesConsole::ProcessEndOfFrame()
 {
 	_cart->RunCoprocessors();
+	_cart->SyncCoprocessors();
 	if(_cart->GetCoprocessor()) {
 		_cart->GetCoprocessor()->ProcessEndOfFrame();
 	}
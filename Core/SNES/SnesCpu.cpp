@@ -31,6 +31,11 @@ void SnesCpu::Exec()
 	_immediateMode = false;
 	_readWriteMask = 0xFFFFFF;
 
+#ifndef DUMMYCPU
+	//Coprocessors catch up at every instruction (or halted cycle) boundary, so an IRQ they raise is sampled during the next instruction
+	_memoryManager->SyncCoprocessors();
+#endif
+
 	if(_state.StopState == SnesCpuStopState::Running) {
 #ifndef DUMMYCPU
 		_emu->ProcessInstruction<CpuType::Snes>();
@@ -69,6 +69,9 @@ void SnesMemoryManager::Initialize(SnesConsole *console)
 
 	_cart->Init(_mappings);
 
+	//The GSU owns the ROM bus while it runs, so ROM reads depend on its state
+	_romSharedWithCoprocessor = _cart->GetGsu() != nullptr;
+
 	GenerateMasterClockTable();
 	Reset();
 }
@@ -128,9 +131,32 @@ void SnesMemoryManager::GenerateMasterClockTable()
 	}
 }
 
+template<uint8_t clocks>
+bool SnesMemoryManager::TryBatchExec()
+{
+	//Advance by the full access length in one step when calling Exec() for each 2 clocks would only
+	//increment the counters: no event in the span, no H=2/6/10 IRQ counter ticks, no pending IRQ
+	//and no debugger needing per-cycle PPU callbacks.
+	if(_hClock < 10 || (uint16_t)(_nextEventClock - _hClock - 1) < clocks || _emu->IsDebugging() || !_regs->CanBatchIrqCounters()) {
+		return false;
+	}
+
+	//The IRQ counters tick on every hclock where (hclock & 0x03) == 2
+	uint16_t tickCount = ((_hClock + clocks + 2) >> 2) - ((_hClock + 2) >> 2);
+
+	_masterClock += clocks;
+	_hClock += clocks;
+	_regs->ProcessIrqCounters(tickCount);
+	return true;
+}
+
 template<uint8_t clocks>
 void SnesMemoryManager::IncMasterClock()
 {
+	if(TryBatchExec<clocks>()) {
+		return;
+	}
+
 	if constexpr(clocks == 2) {
 		Exec();
 	} else if constexpr(clocks == 4) {
@@ -157,12 +183,20 @@ void SnesMemoryManager::IncMasterClock()
 
 void SnesMemoryManager::IncMasterClock4()
 {
+	if(TryBatchExec<4>()) {
+		return;
+	}
+
 	Exec();
 	Exec();
 }
 
 void SnesMemoryManager::IncMasterClock6()
 {
+	if(TryBatchExec<6>()) {
+		return;
+	}
+
 	Exec();
 	Exec();
 	Exec();
@@ -170,6 +204,10 @@ void SnesMemoryManager::IncMasterClock6()
 
 void SnesMemoryManager::IncMasterClock8()
 {
+	if(TryBatchExec<8>()) {
+		return;
+	}
+
 	Exec();
 	Exec();
 	Exec();
@@ -178,6 +216,10 @@ void SnesMemoryManager::IncMasterClock8()
 
 void SnesMemoryManager::IncMasterClock40()
 {
+	if(TryBatchExec<40>()) {
+		return;
+	}
+
 	Exec(); Exec(); Exec(); Exec(); Exec();
 	Exec(); Exec(); Exec(); Exec(); Exec();
 	Exec(); Exec(); Exec(); Exec(); Exec();
@@ -217,10 +259,38 @@ void SnesMemoryManager::Exec()
 	} else if(_hClock & 0x02) {
 		_regs->ProcessIrqCounters();
 	}
+}
 
+void SnesMemoryManager::SyncCoprocessors()
+{
 	_cart->SyncCoprocessors();
 }
 
+void SnesMemoryManager::SyncCoprocessors(IMemoryHandler* handler, uint32_t addr, bool forDma)
+{
+	//Coprocessors only need to catch up before accesses that can see or change their state.
+	//The SA-1's bus conflict timing depends on the memory type last accessed on bus A, so any change to it is a sync point too.
+	MemoryType memType = handler->GetMemoryType();
+	bool needSync;
+	if(handler == _registerHandlerB.get()) {
+		//$2200-$23FF are the SA-1's registers - DMA accesses to bus B don't change the bus A memory type
+		needSync = (addr & 0xFE00) == 0x2200 || (!forDma && memType != _memTypeBusA);
+	} else if(memType != _memTypeBusA) {
+		needSync = true;
+	} else if(handler == _registerHandlerA.get() || memType == MemoryType::SnesWorkRam) {
+		needSync = false;
+	} else if(memType == MemoryType::SnesPrgRom) {
+		needSync = _romSharedWithCoprocessor;
+	} else {
+		//Coprocessor registers, BW-RAM, I-RAM, GSU RAM, etc.
+		needSync = true;
+	}
+
+	if(needSync) {
+		_cart->SyncCoprocessors();
+	}
+}
+
 void SnesMemoryManager::ProcessEvent()
 {
 	switch(_nextEvent) {
@@ -271,7 +341,9 @@ uint8_t SnesMemoryManager::Read(uint32_t addr, MemoryOperationType type)
 	uint8_t value;
 	IMemoryHandler *handler = _mappings.GetHandler(addr);
 	if(handler) {
-		value = handler->Read(addr);
+		SyncCoprocessors(handler, addr, false);
+		uint8_t* page = _mappings.GetReadPage(addr);
+		value = page ? page[addr & 0xFFF] : handler->Read(addr);
 		_memTypeBusA = handler->GetMemoryType();
 		if(handler != _registerHandlerA.get()) {
 			//Reading from the internal CPU bus does not update the external bus
@@ -297,6 +369,7 @@ uint8_t SnesMemoryManager::ReadDma(uint32_t addr, bool forBusA)
 	uint8_t value;
 	IMemoryHandler* handler = _mappings.GetHandler(addr);
 	if(handler) {
+		SyncCoprocessors(handler, addr, true);
 		if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
 			//Trying to read from bus B using bus A returns open bus
 			value = _openBus;
@@ -309,7 +382,8 @@ uint8_t SnesMemoryManager::ReadDma(uint32_t addr, bool forBusA)
 				value = handler->Read(addr);
 			}
 		} else {
-			value = handler->Read(addr);
+			uint8_t* page = _mappings.GetReadPage(addr);
+			value = page ? page[addr & 0xFFF] : handler->Read(addr);
 			if(handler != _registerHandlerB.get()) {
 				_memTypeBusA = handler->GetMemoryType();
 			}
@@ -349,7 +423,13 @@ void SnesMemoryManager::Write(uint32_t addr, uint8_t value, MemoryOperationType
 	if(_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, type)) {
 		IMemoryHandler* handler = _mappings.GetHandler(addr);
 		if(handler) {
-			handler->Write(addr, value);
+			SyncCoprocessors(handler, addr, false);
+			uint8_t* page = _mappings.GetWritePage(addr);
+			if(page) {
+				page[addr & 0xFFF] = value;
+			} else {
+				handler->Write(addr, value);
+			}
 			_memTypeBusA = handler->GetMemoryType();
 		} else {
 			LogDebug("[Debug] Write - missing handler: $" + HexUtilities::ToHex(addr) + " = " + HexUtilities::ToHex(value));
@@ -363,6 +443,7 @@ void SnesMemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA)
 	if(_emu->ProcessMemoryWrite<CpuType::Snes>(addr, value, MemoryOperationType::DmaWrite)) {
 		IMemoryHandler* handler = _mappings.GetHandler(addr);
 		if(handler) {
+			SyncCoprocessors(handler, addr, true);
 			if(forBusA && handler == _registerHandlerB.get() && (addr & 0xFF00) == 0x2100) {
 				//Trying to write to bus B using bus A does nothing
 			} else if(handler == _registerHandlerA.get()) {
@@ -373,7 +454,12 @@ void SnesMemoryManager::WriteDma(uint32_t addr, uint8_t value, bool forBusA)
 					handler->Write(addr, value);
 				}
 			} else {
-				handler->Write(addr, value);
+				uint8_t* page = _mappings.GetWritePage(addr);
+				if(page) {
+					page[addr & 0xFFF] = value;
+				} else {
+					handler->Write(addr, value);
+				}
 				if(handler != _registerHandlerB.get()) {
 					_memTypeBusA = handler->GetMemoryType();
 				}
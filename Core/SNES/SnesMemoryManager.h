@@ -51,6 +51,7 @@ private:
 	uint16_t _dramRefreshPosition = 0;
 	SnesEventType _nextEvent = SnesEventType::DramRefresh;
 	MemoryType _memTypeBusA = MemoryType::SnesPrgRom;
+	bool _romSharedWithCoprocessor = false;
 
 	uint8_t _cpuSpeed = 8;
 	uint8_t _openBus = 0;
@@ -64,9 +65,11 @@ private:
 	Func _execWrite = nullptr;
 	
 	template<uint8_t clocks> void IncMasterClock();
+	template<uint8_t clocks> __forceinline bool TryBatchExec();
 	void UpdateExecCallbacks();
 
 	__forceinline void Exec();
+	__forceinline void SyncCoprocessors(IMemoryHandler* handler, uint32_t addr, bool forDma);
 
 	void ProcessEvent();
 
@@ -84,6 +87,7 @@ public:
 	void IncMasterClock40();
 	void IncMasterClockStartup();
 	void IncrementMasterClockValue(uint16_t value);
+	void SyncCoprocessors();
 
 	uint8_t Read(uint32_t addr, MemoryOperationType type);
 	uint8_t ReadDma(uint32_t addr, bool forBusA);
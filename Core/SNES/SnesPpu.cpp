@@ -20,6 +20,7 @@
 #include "Shared/RewindManager.h"
 #include "Utilities/HexUtilities.h"
 #include "Utilities/Serializer.h"
+#include "Utilities/SimdUtilities.h"
 
 SnesPpu::SnesPpu(Emulator* emu, SnesConsole* console)
 {
@@ -1123,6 +1124,60 @@ uint8_t SnesPpu::GetTilePixelColor(const uint16_t chrData[4], const uint8_t shif
 	return color;
 }
 
+void SnesPpu::GetMode7Addresses(uint16_t tileAddrs[256], uint16_t pixelOffsets[256], int32_t xValue, int32_t yValue, int32_t xStep, int32_t yStep, int start, int end)
+{
+	//Calculates the tilemap address and the offset within the tile's pixel data for each pixel of the line
+	//Pixels outside of the 1024x1024 map have the Mode7OutsideMap flag set in pixelOffsets (their addresses wrap around)
+	int x = start;
+#ifdef MESEN_SSE2
+	__m128i xValues = _mm_add_epi32(_mm_set1_epi32(xValue), _mm_set_epi32(xStep * 3, xStep * 2, xStep, 0));
+	__m128i yValues = _mm_add_epi32(_mm_set1_epi32(yValue), _mm_set_epi32(yStep * 3, yStep * 2, yStep, 0));
+	__m128i xInc = _mm_set1_epi32(xStep * 4);
+	__m128i yInc = _mm_set1_epi32(yStep * 4);
+
+	auto getAddresses = [&](__m128i& tileAddr, __m128i& pixelOffset) {
+		__m128i xOffset = _mm_srai_epi32(xValues, 8);
+		__m128i yOffset = _mm_srai_epi32(yValues, 8);
+		xValues = _mm_add_epi32(xValues, xInc);
+		yValues = _mm_add_epi32(yValues, yInc);
+
+		__m128i insideMap = _mm_cmpeq_epi32(_mm_and_si128(_mm_or_si128(xOffset, yOffset), _mm_set1_epi32(~0x3FF)), _mm_setzero_si128());
+		xOffset = _mm_and_si128(xOffset, _mm_set1_epi32(0x3FF));
+		yOffset = _mm_and_si128(yOffset, _mm_set1_epi32(0x3FF));
+
+		tileAddr = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(yOffset, _mm_set1_epi32(~0x07)), 4), _mm_srli_epi32(xOffset, 3));
+		pixelOffset = _mm_or_si128(_mm_slli_epi32(_mm_and_si128(yOffset, _mm_set1_epi32(0x07)), 3), _mm_and_si128(xOffset, _mm_set1_epi32(0x07)));
+		pixelOffset = _mm_or_si128(pixelOffset, _mm_andnot_si128(insideMap, _mm_set1_epi32(SnesPpu::Mode7OutsideMap)));
+	};
+
+	for(; x + 8 <= end + 1; x += 8) {
+		__m128i tileAddrLow, tileAddrHigh, pixelOffsetLow, pixelOffsetHigh;
+		getAddresses(tileAddrLow, pixelOffsetLow);
+		getAddresses(tileAddrHigh, pixelOffsetHigh);
+
+		//All values fit in 15 bits, so the signed saturation doesn't alter them
+		_mm_storeu_si128((__m128i*)(tileAddrs + x), _mm_packs_epi32(tileAddrLow, tileAddrHigh));
+		_mm_storeu_si128((__m128i*)(pixelOffsets + x), _mm_packs_epi32(pixelOffsetLow, pixelOffsetHigh));
+	}
+
+	xValue += xStep * (x - start);
+	yValue += yStep * (x - start);
+#endif
+
+	for(; x <= end; x++) {
+		int32_t xOffset = xValue >> 8;
+		int32_t yOffset = yValue >> 8;
+		xValue += xStep;
+		yValue += yStep;
+
+		bool outsideMap = ((xOffset | yOffset) & ~0x3FF) != 0;
+		xOffset &= 0x3FF;
+		yOffset &= 0x3FF;
+		tileAddrs[x] = ((yOffset & ~0x07) << 4) | (xOffset >> 3);
+		pixelOffsets[x] = ((yOffset & 0x07) << 3) | (xOffset & 0x07) | (outsideMap ? SnesPpu::Mode7OutsideMap : 0);
+	}
+}
+
 template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority, bool applyMosaic, bool directColorMode>
 void SnesPpu::RenderTilemapMode7()
 {
@@ -1189,39 +1244,32 @@ void SnesPpu::RenderTilemapMode7()
 	
 	uint8_t pixelFlags = ((_state.ColorMathEnabled >> layerIndex) & 0x01) ? PixelFlags::AllowColorMath : 0;
 
-	for(int x = _drawStartX; x <= _drawEndX; x++) {
-		int32_t xOffset = xValue >> 8;
-		int32_t yOffset = yValue >> 8;
-		xValue += xStep;
-		yValue += yStep;
+	uint16_t tileAddrs[256];
+	uint16_t pixelOffsets[256];
+	GetMode7Addresses(tileAddrs, pixelOffsets, xValue, yValue, xStep, yStep, _drawStartX, _drawEndX);
 
+	for(int x = _drawStartX; x <= _drawEndX; x++) {
 		uint8_t tileIndex;
-		if(!_state.Mode7.LargeMap) {
-			yOffset &= 0x3FF;
-			xOffset &= 0x3FF;
-			tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
-		} else {
-			if(yOffset < 0 || yOffset > 0x3FF || xOffset < 0 || xOffset > 0x3FF) {
-				if(_state.Mode7.FillWithTile0) {
-					tileIndex = 0;
-				} else {
-					//Draw nothing for this pixel, we're outside the map
-					continue;
-				}
+		if(_state.Mode7.LargeMap && (pixelOffsets[x] & SnesPpu::Mode7OutsideMap)) {
+			if(_state.Mode7.FillWithTile0) {
+				tileIndex = 0;
 			} else {
-				tileIndex = (uint8_t)_vram[((yOffset & ~0x07) << 4) | (xOffset >> 3)];
+				//Draw nothing for this pixel, we're outside the map
+				continue;
 			}
+		} else {
+			tileIndex = (uint8_t)_vram[tileAddrs[x]];
 		}
 
 		uint16_t colorIndex;
 		uint8_t priority;
 		if constexpr(layerIndex == 1) {
-			uint8_t color = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			uint8_t color = _vram[(tileIndex << 6) + (pixelOffsets[x] & 0x3F)] >> 8;
 			priority = (color & 0x80) ? highPriority : normalPriority;
 			colorIndex = (color & 0x7F);
 		} else {
 			priority = normalPriority;
-			colorIndex = _vram[((tileIndex << 6) + ((yOffset & 0x07) << 3) + (xOffset & 0x07))] >> 8;
+			colorIndex = _vram[(tileIndex << 6) + (pixelOffsets[x] & 0x3F)] >> 8;
 		}
 
 		if(applyMosaic) {
@@ -1269,6 +1317,112 @@ void SnesPpu::DrawSubPixel(uint8_t x, uint16_t color, uint8_t priority)
 	_subScreenPriority[x] = priority;
 }
 
+#ifdef MESEN_SSE2
+template<int shift>
+static __forceinline __m128i ApplyBrightnessToChannel(__m128i pixels, __m128i brightness)
+{
+	__m128i value = _mm_mullo_epi16(_mm_and_si128(_mm_srli_epi16(pixels, shift), _mm_set1_epi16(0x1F)), brightness);
+	//value / 15 (exact for values up to 31*15)
+	value = _mm_srli_epi16(_mm_mulhi_epu16(value, _mm_set1_epi16((short)0x8889)), 3);
+	return _mm_slli_epi16(value, shift);
+}
+#endif
+
+template<bool subtract>
+static __forceinline uint16_t BlendColors(uint16_t pixelA, uint16_t otherPixel, uint8_t halfShift)
+{
+	constexpr unsigned int mask = 0x1F;
+	if constexpr(subtract) {
+		uint16_t r = std::max((int)((pixelA & mask) - (otherPixel & mask)), 0) >> halfShift;
+		uint16_t g = std::max((int)(((pixelA >> 5U) & mask) - ((otherPixel >> 5U) & mask)), 0) >> halfShift;
+		uint16_t b = std::max((int)(((pixelA >> 10U) & mask) - ((otherPixel >> 10U) & mask)), 0) >> halfShift;
+
+		return r | (g << 5U) | (b << 10U);
+	} else {
+		uint16_t r = std::min(((pixelA & mask) + (otherPixel & mask)) >> halfShift, mask);
+		uint16_t g = std::min((((pixelA >> 5U) & mask) + ((otherPixel >> 5U) & mask)) >> halfShift, mask);
+		uint16_t b = std::min((((pixelA >> 10U) & mask) + ((otherPixel >> 10U) & mask)) >> halfShift, mask);
+
+		return r | (g << 5U) | (b << 10U);
+	}
+}
+
+template<bool subtract>
+static void BlendLine(uint16_t* pixels, const uint16_t* otherPixels, const uint16_t* halveMasks, const uint16_t* applyMasks, int start, int end)
+{
+	int x = start;
+#ifdef MESEN_SSE2
+	for(; x + 8 <= end + 1; x += 8) {
+		__m128i a = _mm_loadu_si128((const __m128i*)(pixels + x));
+		__m128i b = _mm_loadu_si128((const __m128i*)(otherPixels + x));
+		__m128i halveMask = _mm_loadu_si128((const __m128i*)(halveMasks + x));
+		__m128i applyMask = _mm_loadu_si128((const __m128i*)(applyMasks + x));
+
+		__m128i result = SimdUtilities::BlendRgb555(a, b, [halveMask](__m128i channelA, __m128i channelB) {
+			__m128i value;
+			if constexpr(subtract) {
+				value = _mm_max_epi16(_mm_sub_epi16(channelA, channelB), _mm_setzero_si128());
+			} else {
+				value = _mm_add_epi16(channelA, channelB);
+			}
+
+			value = _mm_or_si128(_mm_and_si128(halveMask, _mm_srli_epi16(value, 1)), _mm_andnot_si128(halveMask, value));
+			if constexpr(!subtract) {
+				value = _mm_min_epi16(value, _mm_set1_epi16(0x1F));
+			}
+			return value;
+		});
+
+		result = _mm_or_si128(_mm_and_si128(applyMask, result), _mm_andnot_si128(applyMask, a));
+		_mm_storeu_si128((__m128i*)(pixels + x), result);
+	}
+#endif
+
+	for(; x <= end; x++) {
+		if(applyMasks[x]) {
+			pixels[x] = BlendColors<subtract>(pixels[x], otherPixels[x], halveMasks[x] & 0x01);
+		}
+	}
+}
+
+static void DoublePixels(uint16_t* dst, const uint16_t* src, int count)
+{
+	//Process the line backwards, this allows expanding a line in place (when dst == src)
+	int x = count;
+#ifdef MESEN_SSE2
+	for(; x >= 8; x -= 8) {
+		__m128i pixels = _mm_loadu_si128((const __m128i*)(src + x - 8));
+		_mm_storeu_si128((__m128i*)(dst + (x - 8) * 2), _mm_unpacklo_epi16(pixels, pixels));
+		_mm_storeu_si128((__m128i*)(dst + (x - 8) * 2 + 8), _mm_unpackhi_epi16(pixels, pixels));
+	}
+#endif
+
+	while(x > 0) {
+		x--;
+		uint16_t pixel = src[x];
+		dst[x * 2] = pixel;
+		dst[x * 2 + 1] = pixel;
+	}
+}
+
+static void InterleavePixels(uint16_t* dst, const uint16_t* evenPixels, const uint16_t* oddPixels, int count)
+{
+	int x = 0;
+#ifdef MESEN_SSE2
+	for(; x + 8 <= count; x += 8) {
+		__m128i even = _mm_loadu_si128((const __m128i*)(evenPixels + x));
+		__m128i odd = _mm_loadu_si128((const __m128i*)(oddPixels + x));
+		_mm_storeu_si128((__m128i*)(dst + x * 2), _mm_unpacklo_epi16(even, odd));
+		_mm_storeu_si128((__m128i*)(dst + x * 2 + 8), _mm_unpackhi_epi16(even, odd));
+	}
+#endif
+
+	for(; x < count; x++) {
+		dst[x * 2] = evenPixels[x];
+		dst[x * 2 + 1] = oddPixels[x];
+	}
+}
+
 void SnesPpu::ApplyColorMath()
 {
 	if(!_skipRender && _emu->IsDebugging()) {
@@ -1278,30 +1432,54 @@ void SnesPpu::ApplyColorMath()
 	uint8_t activeWindowCount = (uint8_t)_state.Window[0].ActiveLayers[SnesPpu::ColorWindowIndex] + (uint8_t)_state.Window[1].ActiveLayers[SnesPpu::ColorWindowIndex];
 	bool hiResMode = _state.HiResMode || _state.BgMode == 5 || _state.BgMode == 6;
 
+	bool insideWindow[256];
+	for(int x = _drawStartX; x <= _drawEndX; x++) {
+		insideWindow[x] = ProcessMaskWindow<SnesPpu::ColorWindowIndex>(activeWindowCount, x);
+	}
+
+	//The main screen uses the original subscreen colors, so it must be processed first
+	ApplyColorMathToLine<false>(insideWindow);
 	if(hiResMode) {
-		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			bool isInsideWindow = ProcessMaskWindow<SnesPpu::ColorWindowIndex>(activeWindowCount, x);
+		ApplyColorMathToLine<true>(insideWindow);
+	}
+}
 
-			//Keep original subscreen color, which is used to apply color math to the main screen after
-			uint16_t subPixel = _subScreenBuffer[x];
-			//Apply the color math based on the previous main pixel
-			uint16_t prevMainPixel = x > 0 ? _mainScreenBuffer[x - 1] : 0;
-			int prevX = x > 0 ? x - 1 : 0;
-			ApplyColorMathToPixel(_subScreenBuffer[x], prevMainPixel, prevX, isInsideWindow);
+template<bool forSubScreen>
+void SnesPpu::ApplyColorMathToLine(bool insideWindow[256])
+{
+	uint16_t* pixels = forSubScreen ? _subScreenBuffer : _mainScreenBuffer;
 
-			ApplyColorMathToPixel(_mainScreenBuffer[x], subPixel, x, isInsideWindow);
+	//Resolve the window/clip/prevent settings for each pixel first, then blend the whole line at once
+	uint16_t otherPixels[256];
+	uint16_t halveMasks[256];
+	uint16_t applyMasks[256];
+	for(int x = _drawStartX; x <= _drawEndX; x++) {
+		int srcX;
+		uint16_t pixelB;
+		if constexpr(forSubScreen) {
+			//In hi-res modes, subscreen pixels are blended with the previous main screen pixel (after color math)
+			srcX = x > 0 ? x - 1 : 0;
+			pixelB = x > 0 ? _mainScreenBuffer[x - 1] : 0;
+		} else {
+			srcX = x;
+			pixelB = _subScreenBuffer[x];
 		}
+
+		bool halve;
+		applyMasks[x] = PrepareColorMath(pixels[x], pixelB, srcX, insideWindow[x], otherPixels[x], halve) ? 0xFFFF : 0;
+		halveMasks[x] = halve ? 0xFFFF : 0;
+	}
+
+	if(_state.ColorMathSubtractMode) {
+		BlendLine<true>(pixels, otherPixels, halveMasks, applyMasks, _drawStartX, _drawEndX);
 	} else {
-		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			bool isInsideWindow = ProcessMaskWindow<SnesPpu::ColorWindowIndex>(activeWindowCount, x);
-			ApplyColorMathToPixel(_mainScreenBuffer[x], _subScreenBuffer[x], x, isInsideWindow);
-		}
+		BlendLine<false>(pixels, otherPixels, halveMasks, applyMasks, _drawStartX, _drawEndX);
 	}
 }
 
-void SnesPpu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bool isInsideWindow)
+bool SnesPpu::PrepareColorMath(uint16_t &pixelA, uint16_t pixelB, int x, bool isInsideWindow, uint16_t &otherPixel, bool &halve)
 {
-	uint8_t halfShift = (uint8_t)_state.ColorMathHalveResult;
+	halve = _state.ColorMathHalveResult;
 
 	//Set color to black as needed based on clip mode
 	switch(_state.ColorMathClipMode) {
@@ -1311,14 +1489,14 @@ void SnesPpu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bo
 		case ColorWindowMode::OutsideWindow:
 			if(!isInsideWindow) {
 				pixelA = 0;
-				halfShift = 0;
+				halve = false;
 			}
 			break;
 
 		case ColorWindowMode::InsideWindow:
 			if(isInsideWindow) {
 				pixelA = 0;
-				halfShift = 0;
+				halve = false;
 			}
 			break;
 
@@ -1327,7 +1505,7 @@ void SnesPpu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bo
 
 	if(!(_mainScreenFlags[x] & PixelFlags::AllowColorMath)) {
 		//Color math doesn't apply to this pixel
-		return;
+		return false;
 	}
 
 	//Prevent color math as needed based on mode
@@ -1337,54 +1515,52 @@ void SnesPpu::ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bo
 
 		case ColorWindowMode::OutsideWindow:
 			if(!isInsideWindow) {
-				return;
+				return false;
 			}
 			break;
 
 		case ColorWindowMode::InsideWindow:
 			if(isInsideWindow) {
-				return;
+				return false;
 			}
 			break;
 
-		case ColorWindowMode::Always: return;
+		case ColorWindowMode::Always: return false;
 	}
 
-	uint16_t otherPixel;
 	if(_state.ColorMathAddSubscreen) {
 		if(_subScreenPriority[x] > 0) {
 			otherPixel = pixelB;
 		} else {
 			//there's nothing in the subscreen at this pixel, use the fixed color and disable halve operation
 			otherPixel = _state.FixedColor;
-			halfShift = 0;
+			halve = false;
 		}
 	} else {
 		otherPixel = _state.FixedColor;
 	}
-
-	constexpr unsigned int mask = 0x1F;
-	if(_state.ColorMathSubtractMode) {
-		uint16_t r = std::max((int)((pixelA & mask) - (otherPixel & mask)), 0) >> halfShift;
-		uint16_t g = std::max((int)(((pixelA >> 5U) & mask) - ((otherPixel >> 5U) & mask)), 0) >> halfShift;
-		uint16_t b = std::max((int)(((pixelA >> 10U) & mask) - ((otherPixel >> 10U) & mask)), 0) >> halfShift;
-
-		pixelA = r | (g << 5U) | (b << 10U);
-	} else {
-		uint16_t r = std::min(((pixelA & mask) + (otherPixel & mask)) >> halfShift, mask);
-		uint16_t g = std::min((((pixelA >> 5U) & mask) + ((otherPixel >> 5U) & mask)) >> halfShift, mask);
-		uint16_t b = std::min((((pixelA >> 10U) & mask) + ((otherPixel >> 10U) & mask)) >> halfShift, mask);
-
-		pixelA = r | (g << 5U) | (b << 10U);
-	}
+	return true;
 }
 
 template<bool forMainScreen>
 void SnesPpu::ApplyBrightness()
 {
 	if(_state.ScreenBrightness != 15) {
-		for(int x = _drawStartX; x <= _drawEndX; x++) {
-			uint16_t &pixel = (forMainScreen ? _mainScreenBuffer : _subScreenBuffer)[x];
+		uint16_t* pixels = forMainScreen ? _mainScreenBuffer : _subScreenBuffer;
+		int x = _drawStartX;
+#ifdef MESEN_SSE2
+		__m128i brightness = _mm_set1_epi16(_state.ScreenBrightness);
+		for(; x + 8 <= _drawEndX + 1; x += 8) {
+			__m128i pixel = _mm_loadu_si128((const __m128i*)(pixels + x));
+			__m128i result = _mm_or_si128(
+				_mm_or_si128(ApplyBrightnessToChannel<0>(pixel, brightness), ApplyBrightnessToChannel<5>(pixel, brightness)),
+				ApplyBrightnessToChannel<10>(pixel, brightness)
+			);
+			_mm_storeu_si128((__m128i*)(pixels + x), result);
+		}
+#endif
+		for(; x <= _drawEndX; x++) {
+			uint16_t &pixel = pixels[x];
 			uint16_t r = (pixel & 0x1F) * _state.ScreenBrightness / 15;
 			uint16_t g = ((pixel >> 5) & 0x1F) * _state.ScreenBrightness / 15;
 			uint16_t b = ((pixel >> 10) & 0x1F) * _state.ScreenBrightness / 15;
@@ -1410,18 +1586,12 @@ void SnesPpu::ConvertToHiRes()
 	uint16_t scanline = _overscanFrame ? (_scanline - 1) : (_scanline + 6);
 
 	if(_drawStartX > 0) {
-		for(int x = 0; x < _drawStartX; x++) {
-			_currentBuffer[(scanline << 10) + (x << 1)] = _currentBuffer[(scanline << 8) + x];
-			_currentBuffer[(scanline << 10) + (x << 1) + 1] = _currentBuffer[(scanline << 8) + x];
-		}
+		DoublePixels(_currentBuffer + (scanline << 10), _currentBuffer + (scanline << 8), _drawStartX);
 		memcpy(_currentBuffer + (scanline << 10) + 512, _currentBuffer + (scanline << 10), 512 * sizeof(uint16_t));
 	}
 
 	for(int i = scanline - 1; i >= 0; i--) {
-		for(int x = 0; x < 256; x++) {
-			_currentBuffer[(i << 10) + (x << 1)] = _currentBuffer[(i << 8) + x];
-			_currentBuffer[(i << 10) + (x << 1) + 1] = _currentBuffer[(i << 8) + x];
-		}
+		DoublePixels(_currentBuffer + (i << 10), _currentBuffer + (i << 8), 256);
 		memcpy(_currentBuffer + (i << 10) + 512, _currentBuffer + (i << 10), 512 * sizeof(uint16_t));
 	}
 }
@@ -1438,17 +1608,13 @@ void SnesPpu::ApplyHiResMode()
 		uint32_t screenY = _state.ScreenInterlace ? (_oddFrame ? ((scanline << 1) + 1) : (scanline << 1)) : (scanline << 1);
 		uint32_t baseAddr = (screenY << 9);
 
+		uint16_t* dst = _currentBuffer + baseAddr + (_drawStartX << 1);
+		int count = _drawEndX - _drawStartX + 1;
 		if(IsDoubleWidth()) {
 			ApplyBrightness<false>();
-			for(int x = _drawStartX; x <= _drawEndX; x++) {
-				_currentBuffer[baseAddr + (x << 1)] = _subScreenBuffer[x];
-				_currentBuffer[baseAddr + (x << 1) + 1] = _mainScreenBuffer[x];
-			}
+			InterleavePixels(dst, _subScreenBuffer + _drawStartX, _mainScreenBuffer + _drawStartX, count);
 		} else {
-			for(int x = _drawStartX; x <= _drawEndX; x++) {
-				_currentBuffer[baseAddr + (x << 1)] = _mainScreenBuffer[x];
-				_currentBuffer[baseAddr + (x << 1) + 1] = _mainScreenBuffer[x];
-			}
+			DoublePixels(dst, _mainScreenBuffer + _drawStartX, count);
 		}
 
 		if(!_state.ScreenInterlace) {
@@ -21,6 +21,7 @@ public:
 private:
 	constexpr static int SpriteLayerIndex = 4;
 	constexpr static int ColorWindowIndex = 5;
+	constexpr static uint16_t Mode7OutsideMap = 0x4000;
 
 	Emulator* _emu;
 	SnesConsole* _console;
@@ -172,6 +173,8 @@ private:
 	template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority, bool applyMosaic>
 	__forceinline void RenderTilemapMode7();
 
+	void GetMode7Addresses(uint16_t tileAddrs[256], uint16_t pixelOffsets[256], int32_t xValue, int32_t yValue, int32_t xStep, int32_t yStep, int start, int end);
+
 	template<uint8_t layerIndex, uint8_t normalPriority, uint8_t highPriority, bool applyMosaic, bool directColorMode>
 	void RenderTilemapMode7();
 
@@ -179,7 +182,9 @@ private:
 	__forceinline void DrawSubPixel(uint8_t x, uint16_t color, uint8_t priority);
 
 	void ApplyColorMath();
-	void ApplyColorMathToPixel(uint16_t &pixelA, uint16_t pixelB, int x, bool isInsideWindow);
+	template<bool forSubScreen>
+	void ApplyColorMathToLine(bool insideWindow[256]);
+	bool PrepareColorMath(uint16_t &pixelA, uint16_t pixelB, int x, bool isInsideWindow, uint16_t &otherPixel, bool &halve);
 	
 	template<bool forMainScreen>
 	void ApplyBrightness();
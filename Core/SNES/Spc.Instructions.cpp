@@ -18,6 +18,9 @@ void Spc::Run()
 	//Minus 1 because each call to ProcessCycle increments _state.Cycle by 2
 	int64_t targetCycle = (int64_t)(_memoryManager->GetMasterClock() * _clockRatio) - 1;
 	while((int64_t)_state.Cycle < targetCycle) {
+		if(_opStep == SpcOpStep::ReadOpCode && SkipIdleLoop(targetCycle)) {
+			continue;
+		}
 		ProcessCycle();
 	}
 }
@@ -102,6 +102,7 @@ void Spc::Reset()
 	_tmp3 = 0;
 	_operandA = 0;
 	_operandB = 0;
+	_idleLoopValid = false;
 
 	_dsp->Reset();
 }
@@ -131,6 +132,7 @@ void Spc::UpdateClockRatio()
 	uint64_t targetCycle = (uint64_t)(_memoryManager->GetMasterClock() * _clockRatio);
 	if(std::abs((int64_t)targetCycle - (int64_t)_state.Cycle) > 20) {
 		_state.Cycle = targetCycle;
+		_idleLoopValid = false;
 	}
 }
 
@@ -180,6 +182,113 @@ void Spc::IncCycleCount(int32_t addr)
 	_state.Timer2.Run(timerInc);
 }
 
+uint8_t Spc::ReadCodeByte(uint16_t addr)
+{
+	//Side effect-free read, only used on addresses outside of the register range
+	return (addr >= 0xFFC0 && _state.RomEnabled) ? _spcBios[addr & 0x3F] : _ram[addr];
+}
+
+uint8_t Spc::GetIdleLoopLength(uint16_t addr)
+{
+	//Returns the number of cycles taken by one iteration of a loop that only polls one of the CPU ports
+	//and branches back to itself (e.g "MOV A, $F4 / BNE" or the IPL ROM's "CMP $F4, #$CC / BNE"), or 0
+	if(addr >= 0xE8 && addr < 0x100) {
+		return 0;
+	}
+
+	auto isBranch = [](uint8_t opCode) {
+		//BPL, BMI, BNE, BEQ
+		return opCode == 0x10 || opCode == 0x30 || opCode == 0xD0 || opCode == 0xF0;
+	};
+
+	auto isPort = [](uint8_t dp) {
+		return dp >= 0xF4 && dp <= 0xF7;
+	};
+
+	uint8_t opCode = ReadCodeByte(addr);
+	uint8_t dp = ReadCodeByte(addr + 1);
+	switch(opCode) {
+		case 0xE4: case 0xF8: case 0xEB: //MOV A/X/Y, dp
+		case 0x64: case 0x3E: case 0x7E: //CMP A/X/Y, dp
+			if(isPort(dp)) {
+				uint8_t next = ReadCodeByte(addr + 2);
+				if(isBranch(next) && ReadCodeByte(addr + 3) == 0xFC) {
+					return 3 + 4;
+				}
+
+				//MOV A/X/Y, dp + CMP A/X/Y, #imm
+				uint8_t cmpOpCode = opCode == 0xE4 ? 0x68 : (opCode == 0xF8 ? 0xC8 : (opCode == 0xEB ? 0xAD : 0));
+				if(cmpOpCode && next == cmpOpCode && isBranch(ReadCodeByte(addr + 4)) && ReadCodeByte(addr + 5) == 0xFA) {
+					return 3 + 2 + 4;
+				}
+			}
+			break;
+
+		case 0x78: //CMP dp, #imm
+			if(isPort(ReadCodeByte(addr + 2)) && isBranch(ReadCodeByte(addr + 3)) && ReadCodeByte(addr + 4) == 0xFB) {
+				return 5 + 4;
+			}
+			break;
+
+		case 0x2E: //CBNE dp, rel
+			if(isPort(dp) && ReadCodeByte(addr + 2) == 0xFD) {
+				return 7;
+			}
+			break;
+	}
+
+	return 0;
+}
+
+bool Spc::SkipIdleLoop(int64_t targetCycle)
+{
+	//Called before each opcode fetch
+	if(_state.PC != _idleLoopPc) {
+		uint8_t length = GetIdleLoopLength(_state.PC);
+		if(length) {
+			_idleLoopPc = _state.PC;
+			_idleLoopLength = length;
+			_idleLoopCycle = _state.Cycle;
+			_idleLoopValid = true;
+		}
+		return false;
+	}
+
+	//Only skip once a full iteration of the loop has run with the current port values.
+	//Since the loop has no side effects besides A/X/Y and the flags, every following iteration
+	//will produce the exact same result until the CPU writes to a port.
+	//This requires every memory access to take 2 cycles, and the debugger to be inactive (breakpoints, etc.)
+	bool canSkip = (
+		_idleLoopValid &&
+		_state.Cycle - _idleLoopCycle == (uint64_t)_idleLoopLength * 2 &&
+		_state.InternalSpeed == 0 && _state.ExternalSpeed == 0 &&
+		!_pendingCpuRegUpdate &&
+		!CheckFlag(SpcFlags::DirectPage) &&
+		!_emu->IsDebugging() &&
+		GetIdleLoopLength(_state.PC) == _idleLoopLength
+	);
+
+	_idleLoopValid = true;
+	if(!canSkip) {
+		_idleLoopCycle = _state.Cycle;
+		return false;
+	}
+
+	//Run as many full iterations as the normal execution loop would, only clocking the DSP and timers
+	uint64_t cycleCount = ((uint64_t)(targetCycle - (int64_t)_state.Cycle) + 1) / 2;
+	uint64_t iterations = cycleCount / _idleLoopLength;
+	if(iterations == 0) {
+		_idleLoopCycle = _state.Cycle;
+		return false;
+	}
+
+	for(uint64_t i = 0, end = iterations * _idleLoopLength; i < end; i++) {
+		IncCycleCount(-1);
+	}
+	_idleLoopCycle = _state.Cycle - (uint64_t)_idleLoopLength * 2;
+	return true;
+}
+
 uint8_t Spc::DebugRead(uint16_t addr)
 {
 	if(addr >= 0xFFC0 && _state.RomEnabled) {
@@ -358,6 +467,9 @@ void Spc::CpuWriteRegister(uint32_t addr, uint8_t value)
 	if(_state.NewCpuRegs[addr & 0x03] != value) {
 		_state.NewCpuRegs[addr & 0x03] = value;
 
+		//Any idle loop polling the ports may now exit
+		_idleLoopValid = false;
+
 		//If the CPU's write lands in the first half of the SPC cycle (each cycle is 2 clocks) then the SPC 
 		//can see the new value immediately, otherwise it only sees the new value on the following cycle.
 		//The delay is needed for Kishin Kishin Douji Zenki to boot.
@@ -479,6 +591,10 @@ void Spc::Serialize(Serializer &s)
 
 	SV(_dsp);
 
+	if(!s.IsSaving()) {
+		_idleLoopValid = false;
+	}
+
 	if(s.GetFormat() != SerializeFormat::Map) {
 		if(!s.IsSaving()) {
 			UpdateClockRatio();
@@ -598,6 +714,7 @@ void Spc::LoadSpcFile(SpcFileData* data)
 	_dsp->LoadSpcFileRegs(data->DspRegs);
 
 	_state.PC = data->PC;
+	_idleLoopValid = false;
 	_state.A = data->A;
 	_state.X = data->X;
 	_state.Y = data->Y;
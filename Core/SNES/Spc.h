@@ -52,6 +52,12 @@ private:
 	bool _pendingCpuRegUpdate = false;
 	uint32_t _spcSampleRate = Spc::SpcSampleRate;
 
+	/* Idle loop detection (tight loops that poll the CPU ports) */
+	uint64_t _idleLoopCycle = 0;
+	int32_t _idleLoopPc = -1;
+	uint8_t _idleLoopLength = 0;
+	bool _idleLoopValid = false;
+
 	SpcState _state;
 	uint8_t* _ram;
 	uint8_t _spcBios[64] {
@@ -284,6 +290,10 @@ private:
 	void EndAddr();
 	__forceinline void ProcessCycle();
 	__forceinline void Exec();
+
+	uint8_t ReadCodeByte(uint16_t addr);
+	uint8_t GetIdleLoopLength(uint16_t addr);
+	bool SkipIdleLoop(int64_t targetCycle);
 	
 	void UpdateClockRatio();
 	void ExitExecLoop();
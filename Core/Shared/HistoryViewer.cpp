@@ -18,10 +18,13 @@ HistoryViewer::HistoryViewer(Emulator* emu)
 	_emu = emu;
 	_position = 0;
 	_pollCounter = 0;
+	_stopFlag = false;
+	_prefetchPosition = 0;
 }
 
 HistoryViewer::~HistoryViewer()
 {
+	StopPrefetchThread();
 }
 
 bool HistoryViewer::Initialize(Emulator* mainEmu)
@@ -44,16 +47,151 @@ bool HistoryViewer::Initialize(Emulator* mainEmu)
 	//Disable battery saving for this instance
 	_emu->GetBatteryManager()->Initialize("");
 	
+	StopPrefetchThread();
 	_history = mainEmu->GetRewindManager()->GetHistory();
+	BuildKeyFrameIndex();
 	
 	_emu->UnregisterInputProvider(this);
 	_emu->RegisterInputProvider(this);
+
+	_stopFlag = false;
+	_prefetchThread.reset(new thread(&HistoryViewer::PrefetchThread, this));
 	
 	SeekTo(0);
 
 	return true;
 }
 
+void HistoryViewer::BuildKeyFrameIndex()
+{
+	_keyFrames.clear();
+	_keyFrameIndex.clear();
+	_stateCache.clear();
+
+	int32_t keyFrame = -1;
+	for(size_t i = 0; i < _history.size(); i++) {
+		if(_history[i].IsFullState) {
+			keyFrame = (int32_t)_keyFrames.size();
+			_keyFrames.push_back((uint32_t)i);
+		}
+		_keyFrameIndex.push_back(keyFrame);
+	}
+}
+
+shared_ptr<vector<uint8_t>> HistoryViewer::GetCachedState(uint32_t position)
+{
+	auto lock = _cacheLock.AcquireSafe();
+	for(size_t i = 0; i < _stateCache.size(); i++) {
+		if(_stateCache[i].first == position) {
+			auto entry = _stateCache[i];
+			_stateCache.erase(_stateCache.begin() + i);
+			_stateCache.push_front(entry);
+			return entry.second;
+		}
+	}
+	return nullptr;
+}
+
+shared_ptr<vector<uint8_t>> HistoryViewer::GetState(uint32_t position)
+{
+	shared_ptr<vector<uint8_t>> state = GetCachedState(position);
+	if(state) {
+		return state;
+	}
+
+	state.reset(new vector<uint8_t>());
+	if(!_history[position].DecompressStateData(*state)) {
+		return nullptr;
+	}
+
+	int32_t keyFrame = _keyFrameIndex[position];
+	if(!_history[position].IsFullState && keyFrame >= 0) {
+		//XOR with the previous full state (usually already cached) to restore the state data
+		shared_ptr<vector<uint8_t>> keyFrameState = GetState(_keyFrames[keyFrame]);
+		if(keyFrameState) {
+			vector<uint8_t>& data = *state;
+			vector<uint8_t>& keyFrameData = *keyFrameState;
+			for(size_t i = 0, len = std::min(keyFrameData.size(), data.size()); i < len; i++) {
+				data[i] ^= keyFrameData[i];
+			}
+		}
+	}
+
+	auto lock = _cacheLock.AcquireSafe();
+	for(auto& entry : _stateCache) {
+		if(entry.first == position) {
+			//Decoded by another thread in the meantime
+			return entry.second;
+		}
+	}
+
+	_stateCache.emplace_front(position, state);
+	if(_stateCache.size() > HistoryViewer::MaxCachedStates) {
+		_stateCache.pop_back();
+	}
+	return state;
+}
+
+void HistoryViewer::LoadState(Emulator* emu, uint32_t position)
+{
+	shared_ptr<vector<uint8_t>> state = GetState(position);
+	if(state) {
+		stringstream stream;
+		stream.write((char*)state->data(), state->size());
+		stream.seekg(0, ios::beg);
+		emu->Deserialize(stream, SaveStateManager::FileFormatVersion, true);
+	}
+}
+
+void HistoryViewer::StartPrefetch(uint32_t position)
+{
+	if(_prefetchThread) {
+		_prefetchPosition = position;
+		_prefetchSignal.Signal();
+	}
+}
+
+void HistoryViewer::StopPrefetchThread()
+{
+	_stopFlag = true;
+	if(_prefetchThread) {
+		_prefetchSignal.Signal();
+		_prefetchThread->join();
+		_prefetchThread.reset();
+	}
+}
+
+void HistoryViewer::PrefetchThread()
+{
+	while(!_stopFlag) {
+		_prefetchSignal.Wait();
+		if(_stopFlag) {
+			break;
+		}
+
+		uint32_t position = _prefetchPosition;
+		if(position >= _history.size()) {
+			continue;
+		}
+
+		//Decode the next block ahead of time, it is loaded as soon as playback reaches the end of the current one
+		if(position + 1 < _history.size()) {
+			GetState(position + 1);
+		}
+
+		//Decode the key frames around the current position, seeking near them only needs to decompress a single block
+		int32_t keyFrame = _keyFrameIndex[position];
+		for(int32_t i = 1; i <= HistoryViewer::PrefetchDistance && !_stopFlag && _prefetchPosition == position; i++) {
+			if(keyFrame + i < (int32_t)_keyFrames.size()) {
+				GetState(_keyFrames[keyFrame + i]);
+			}
+			if(keyFrame - i >= 0) {
+				GetState(_keyFrames[keyFrame - i]);
+			}
+		}
+	}
+}
+
 void HistoryViewer::SetOptions(HistoryViewerOptions options)
 {
 	if(options.IsPaused) {
@@ -101,8 +239,8 @@ void HistoryViewer::SeekTo(uint32_t seekPosition)
 		auto lock = _emu->AcquireLock();
 		
 		_position = seekPosition;
-		RewindData rewindData = _history[_position];
-		rewindData.LoadState(_emu, _history, _position);
+		LoadState(_emu, _position);
+		StartPrefetch(_position);
 
 		_emu->GetSoundMixer()->StopAudio(true);
 		_pollCounter = 0;
@@ -118,9 +256,14 @@ bool HistoryViewer::CreateSaveState(string outputFile, uint32_t position)
 	position /= RewindManager::BufferSize;
 	position = std::min(position, (uint32_t)_history.size() - 1);
 
+	shared_ptr<vector<uint8_t>> state = GetState(position);
+	if(!state) {
+		return false;
+	}
+
 	std::stringstream stateData;
 	_emu->GetSaveStateManager()->GetSaveStateHeader(stateData);
-	_history[position].GetStateData(stateData, _history, position);
+	stateData.write((char*)state->data(), state->size());
 
 	ofstream output(outputFile, ios::binary);
 	if(output) {
@@ -143,8 +286,9 @@ bool HistoryViewer::SaveMovie(string movieFile, uint32_t startPosition, uint32_t
 	_emu->Serialize(state, true, false);
 
 	//Convert the rewind data to a .mmo file
+	shared_ptr<vector<uint8_t>> startState = startPosition < _history.size() ? GetState(startPosition) : nullptr;
 	unique_ptr<MovieRecorder> recorder(new MovieRecorder(_emu));
-	bool result = recorder->CreateMovie(movieFile, _history, startPosition, endPosition, _mainEmu->GetBatteryManager()->HasBattery());
+	bool result = recorder->CreateMovie(movieFile, _history, startPosition, endPosition, _mainEmu->GetBatteryManager()->HasBattery(), startState.get());
 
 	//Resume the state and resume
 	_emu->Deserialize(state, SaveStateManager::FileFormatVersion, true);
@@ -167,9 +311,9 @@ void HistoryViewer::ResumeGameplay(uint32_t resumePosition)
 	}
 
 	if(resumePosition < _history.size()) {
-		_history[resumePosition].LoadState(_mainEmu, _history, resumePosition);
+		LoadState(_mainEmu, resumePosition);
 	} else {
-		_history[_history.size() - 1].LoadState(_mainEmu, _history, (int32_t)_history.size() - 1);
+		LoadState(_mainEmu, (uint32_t)_history.size() - 1);
 	}
 }
 
@@ -206,7 +350,7 @@ void HistoryViewer::ProcessEndOfFrame()
 			return;
 		}
 
-		RewindData rewindData = _history[_position];
-		rewindData.LoadState(_emu, _history, _position);
+		LoadState(_emu, _position);
+		StartPrefetch(_position);
 	}
 }
@@ -3,6 +3,8 @@
 #include <deque>
 #include "Shared/Interfaces/IInputProvider.h"
 #include "Shared/RewindData.h"
+#include "Utilities/SimpleLock.h"
+#include "Utilities/AutoResetEvent.h"
 
 class Emulator;
 class BaseControlDevice;
@@ -30,12 +32,37 @@ struct HistoryViewerOptions
 class HistoryViewer : public IInputProvider
 {
 private:
+	static constexpr size_t MaxCachedStates = 16;
+	static constexpr int32_t PrefetchDistance = 2;
+
 	Emulator* _emu = nullptr;
 	Emulator* _mainEmu = nullptr;
 	deque<RewindData> _history;
 	uint32_t _position = 0;
 	uint32_t _pollCounter = 0;
 
+	//Positions of all full states, and for each position, the index of the full state its data is XORed with (-1 if none)
+	vector<uint32_t> _keyFrames;
+	vector<int32_t> _keyFrameIndex;
+
+	//Most recently used decoded (uncompressed, XOR-free) states, keyed by position
+	SimpleLock _cacheLock;
+	deque<std::pair<uint32_t, shared_ptr<vector<uint8_t>>>> _stateCache;
+
+	unique_ptr<thread> _prefetchThread;
+	AutoResetEvent _prefetchSignal;
+	atomic<bool> _stopFlag;
+	atomic<uint32_t> _prefetchPosition;
+
+	void BuildKeyFrameIndex();
+	shared_ptr<vector<uint8_t>> GetCachedState(uint32_t position);
+	shared_ptr<vector<uint8_t>> GetState(uint32_t position);
+	void LoadState(Emulator* emu, uint32_t position);
+
+	void StartPrefetch(uint32_t position);
+	void StopPrefetchThread();
+	void PrefetchThread();
+
 public:
 	HistoryViewer(Emulator* emu);
 	virtual ~HistoryViewer();
@@ -193,7 +193,7 @@ void MovieRecorder::ProcessNotification(ConsoleNotificationType type, void *para
 	}
 }
 
-bool MovieRecorder::CreateMovie(string movieFile, deque<RewindData> &data, uint32_t startPosition, uint32_t endPosition, bool hasBattery)
+bool MovieRecorder::CreateMovie(string movieFile, deque<RewindData> &data, uint32_t startPosition, uint32_t endPosition, bool hasBattery, vector<uint8_t>* startState)
 {
 	shared_ptr<IConsole> console = _emu->GetConsole();
 	if(!console) {
@@ -210,13 +210,18 @@ bool MovieRecorder::CreateMovie(string movieFile, deque<RewindData> &data, uint3
 			_hasSaveState = true;
 			_saveStateData = stringstream();
 			_emu->GetSaveStateManager()->GetSaveStateHeader(_saveStateData);
-			data[startPosition].GetStateData(_saveStateData, data, startPosition);
+			if(startState) {
+				//State was already decoded by the caller
+				_saveStateData.write((char*)startState->data(), startState->size());
+			} else {
+				data[startPosition].GetStateData(_saveStateData, data, startPosition);
+			}
 		}
 
 		_inputData = stringstream();
 
 		for(uint32_t i = startPosition; i < endPosition; i++) {
-			RewindData rewindData = data[i];
+			RewindData& rewindData = data[i];
 			for(uint32_t j = 0; j < RewindManager::BufferSize; j++) {
 				for(shared_ptr<BaseControlDevice> &device : devices) {
 					uint8_t port = device->GetPort();
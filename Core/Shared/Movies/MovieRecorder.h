@@ -48,5 +48,5 @@ public:
 	// Inherited via INotificationListener
 	void ProcessNotification(ConsoleNotificationType type, void *parameter) override;
 
-	bool CreateMovie(string movieFile, deque<RewindData>& data, uint32_t startPosition, uint32_t endPosition, bool hasBattery);
+	bool CreateMovie(string movieFile, deque<RewindData>& data, uint32_t startPosition, uint32_t endPosition, bool hasBattery, vector<uint8_t>* startState = nullptr);
 };
@@ -17,6 +17,15 @@ void RewindData::GetStateData(stringstream &stateData, deque<RewindData>& prevSt
 	stateData.write((char*)data.data(), data.size());
 }
 
+bool RewindData::DecompressStateData(vector<uint8_t>& data)
+{
+	//Only decompresses this block's data, the caller is responsible for XORing it with the previous full state
+	if(_saveStateData.size() == 0) {
+		return false;
+	}
+	return CompressionHelper::Decompress(_saveStateData, data);
+}
+
 template<typename T>
 void RewindData::ProcessXorState(T& data, deque<RewindData>& prevStates, int32_t position)
 {
@@ -21,6 +21,7 @@ public:
 	bool IsFullState = false;
 
 	void GetStateData(stringstream& stateData, deque<RewindData>& prevStates, int32_t position);
+	bool DecompressStateData(vector<uint8_t>& data);
 	uint32_t GetStateSize() { return (uint32_t)_saveStateData.size(); }
 
 	void LoadState(Emulator* emu, deque<RewindData>& prevStates, int32_t position = -1, bool sendNotification = true);
@@ -769,6 +769,7 @@ struct WsConfig
 
 	bool HideBgLayers[2] = {};
 	bool DisableSprites = false;
+	bool DisableFrameSkipping = false;
 
 	WsAudioMode AudioMode = WsAudioMode::Headphones;
 	uint32_t Channel1Vol = 100;
@@ -874,6 +875,8 @@ struct DebugConfig
 	bool ScriptAllowIoOsAccess = false;
 	bool ScriptAllowNetworkAccess = false;
 	uint32_t ScriptTimeout = 1;
+
+	uint32_t StepBackCheckpointInterval = 0;
 };
 
 enum class HudDisplaySize
@@ -1475,17 +1475,26 @@ void OPLL_resetPatch(OPLL *opll, uint8_t type) {
     OPLL_copyPatch(opll, i, &default_patch[type % OPLL_TONE_NUM][i]);
 }
 
-int16_t OPLL_calc(OPLL *opll) {
-  while (opll->out_step > opll->out_time) {
-    opll->out_time += opll->inp_step;
-    update_output(opll);
-    mix_output(opll);
-  }
-  opll->out_time -= opll->out_step;
-  if (opll->conv) {
-    opll->mix_out[0] = OPLL_RateConv_getData(opll->conv, 0);
+void OPLL_calcBlock(OPLL *opll, int16_t *out, uint32_t count, uint32_t stride) {
+  for (uint32_t i = 0; i < count; i++) {
+    while (opll->out_step > opll->out_time) {
+      opll->out_time += opll->inp_step;
+      update_output(opll);
+      mix_output(opll);
+    }
+    opll->out_time -= opll->out_step;
+    if (opll->conv) {
+      opll->mix_out[0] = OPLL_RateConv_getData(opll->conv, 0);
+    }
+    *out = opll->mix_out[0];
+    out += stride;
   }
-  return opll->mix_out[0];
+}
+
+int16_t OPLL_calc(OPLL *opll) {
+  int16_t out;
+  OPLL_calcBlock(opll, &out, 1, 1);
+  return out;
 }
 
 void OPLL_calcStereo(OPLL *opll, int32_t out[2]) {
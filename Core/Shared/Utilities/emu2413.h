@@ -180,6 +180,11 @@ void OPLL_writeReg(OPLL *opll, uint32_t reg, uint8_t val);
  */
 int16_t OPLL_calc(OPLL *opll);
 
+/**
+ * Calculate count samples, writing one sample every stride entries in out
+ */
+void OPLL_calcBlock(OPLL *opll, int16_t *out, uint32_t count, uint32_t stride);
+
 /**
  * Calulate stereo sample
  */
@@ -8,6 +8,7 @@
 #include "Shared/NotificationManager.h"
 #include "Shared/RewindManager.h"
 #include "Shared/Video/VideoDecoder.h"
+#include "Shared/Video/VideoRenderer.h"
 #include "Shared/RenderedFrame.h"
 #include "Shared/EventType.h"
 #include "Shared/MessageManager.h"
@@ -42,6 +43,12 @@ WsPpu::WsPpu(Emulator* emu, WsConsole* console, WsMemoryManager* memoryManager,
 	memset(_outputBuffers[1], 0, WsConstants::MaxPixelCount * sizeof(uint16_t));
 	_currentBuffer = _outputBuffers[0];
 
+	for(int i = 0; i < 256; i++) {
+		for(int j = 0; j < 8; j++) {
+			_planarTileLut[i] |= ((i >> (7 - j)) & 0x01) << (j * 4);
+		}
+	}
+
 	_showIcons = _emu->GetSettings()->GetWsConfig().LcdShowIcons;
 }
 
@@ -59,7 +66,7 @@ void WsPpu::SetVideoMode(WsVideoMode mode)
 void WsPpu::ProcessHblank()
 {
 	_timer->TickHorizontalTimer();
-	if(_state.Scanline < WsConstants::ScreenHeight) {
+	if(_state.Scanline < WsConstants::ScreenHeight && !_skipRender) {
 		switch(_state.Mode) {
 			case WsVideoMode::Monochrome: DrawScanline<WsVideoMode::Monochrome>(); break;
 			case WsVideoMode::Color2bpp: DrawScanline<WsVideoMode::Color2bpp>(); break;
@@ -89,8 +96,21 @@ void WsPpu::ProcessEndOfScanline()
 		_state.Mode = _state.NextMode;
 		_state.Scanline = 0;
 		_emu->ProcessEvent(EventType::StartFrame, CpuType::Ws);
-		_currentBuffer = _currentBuffer == _outputBuffers[0] ? _outputBuffers[1] : _outputBuffers[0];
-		_showIcons = _emu->GetSettings()->GetWsConfig().LcdShowIcons;
+
+		EmuSettings* settings = _emu->GetSettings();
+		_skipRender = (
+			_emu->IsRunAheadFrame() || (
+				!settings->GetWsConfig().DisableFrameSkipping &&
+				!_emu->GetRewindManager()->IsRewinding() &&
+				!_emu->GetVideoRenderer()->IsRecording() &&
+				(settings->GetEmulationSpeed() == 0 || settings->GetEmulationSpeed() > 150) &&
+				_frameSkipTimer.GetElapsedMS() < 15
+			)
+		);
+		if(!_skipRender) {
+			_currentBuffer = _currentBuffer == _outputBuffers[0] ? _outputBuffers[1] : _outputBuffers[0];
+		}
+		_showIcons = settings->GetWsConfig().LcdShowIcons;
 	} else if(_state.Scanline == 145) {
 		SendFrame();
 	} else if(_state.Scanline == 144) {
@@ -155,7 +175,11 @@ void WsPpu::DrawSprites()
 			}
 
 			uint16_t tileDataAddr = (bank0Addr + tileIndex * tileSize + tileRow * tileBytesPerRow);
-			for(int j = 0; j < 8; j++) {
+			uint32_t tileData = GetTileRow<mode>(tileDataAddr, hMirror);
+			bool transparent = (palette & 0x04) || mode > WsVideoMode::Color2bpp;
+
+			//Rows where every pixel is transparent can be skipped entirely
+			for(int j = 0; j < 8 && (tileData != 0 || !transparent); j++, tileData >>= 4) {
 				uint8_t x = sprX + j;
 
 				if(x >= 224) {
@@ -167,13 +191,8 @@ void WsPpu::DrawSprites()
 					continue;
 				}
 
-				int tileColumn = j;
-				if(hMirror) {
-					tileColumn = 7 - tileColumn;
-				}
-
-				uint8_t color = GetPixelColor<mode>(tileDataAddr, tileColumn);
-				if(color != 0 || (!(palette & 0x04) && mode <= WsVideoMode::Color2bpp)) {
+				uint8_t color = tileData & 0x0F;
+				if(color != 0 || !transparent) {
 					_rowData[rowIndex][x] = { palette, color, highPriority ? (uint8_t)2 : (uint8_t)1 };
 				}
 			}
@@ -219,9 +238,6 @@ void WsPpu::DrawBackground()
 		uint8_t palette = (tilemapData >> 9) & 0x0F;
 		bool vMirror = tilemapData & 0x8000;
 		bool hMirror = tilemapData & 0x4000;
-		if(hMirror) {
-			tileColumn = 7 - tileColumn;
-		}
 		if(vMirror) {
 			tileRow = 7 - tileRow;
 		}
@@ -229,9 +245,17 @@ void WsPpu::DrawBackground()
 		uint16_t tilesetAddr = mode >= WsVideoMode::Color2bpp && (tilemapData & 0x2000) ? bank1Addr : bank0Addr;
 		uint16_t tileDataAddr = (tilesetAddr + tileIndex * tileSize + tileRow * tileBytesPerRow);
 
-		for(int i = cycle, end = std::min<int>(cycle + counter, WsConstants::ScreenWidth); i < end; i++) {
-			uint8_t color = GetPixelColor<mode>(tileDataAddr, tileColumn);
-			tileColumn += (hMirror ? -1 : 1);
+		//Decode the whole tile row at once, one nibble per pixel
+		uint32_t tileData = GetTileRow<mode>(tileDataAddr, hMirror) >> (tileColumn * 4);
+		bool transparent = (palette & 0x04) || mode > WsVideoMode::Color2bpp;
+		if(tileData == 0 && transparent) {
+			//Nothing to draw for the rest of this tile
+			cycle += counter - 1;
+			continue;
+		}
+
+		for(int i = cycle, end = std::min<int>(cycle + counter, WsConstants::ScreenWidth); i < end; i++, tileData >>= 4) {
+			uint8_t color = tileData & 0x0F;
 
 			if(_rowData[rowIndex][i].Priority >= layerIndex + 1) {
 				continue;
@@ -245,7 +269,7 @@ void WsPpu::DrawBackground()
 			}
 
 			//"In two bit per pixel modes: Palettes 0-3 and 8-11 are opaque. For these, index zero is treated as opaque."
-			if(color != 0 || (!(palette & 0x04) && mode <= WsVideoMode::Color2bpp)) {
+			if(color != 0 || !transparent) {
 				_rowData[rowIndex][i] = { palette, color, (uint8_t)(layerIndex + 1) };
 			}
 		}
@@ -255,45 +279,43 @@ void WsPpu::DrawBackground()
 }
 
 template<WsVideoMode mode>
-uint16_t WsPpu::GetPixelColor(uint16_t tileAddr, uint8_t column)
+uint32_t WsPpu::GetTileRow(uint16_t tileAddr, bool hMirror)
 {
+	//Returns the 8 pixels of the tile row, 4 bits each, leftmost pixel in the lowest bits
+	uint32_t tileData = 0;
 	switch(mode) {
-		case WsVideoMode::Monochrome: {
-			uint8_t tileData = _vram[tileAddr];
-			uint8_t tileData2 = _vram[tileAddr + 1];
-			return (
-				((tileData << column) & 0x80) >> 7 |
-				((tileData2 << column) & 0x80) >> 6
+		case WsVideoMode::Monochrome:
+		case WsVideoMode::Color2bpp:
+			tileData = (
+				_planarTileLut[_vram[tileAddr]] |
+				(_planarTileLut[_vram[tileAddr + 1]] << 1)
 			);
-		}
+			break;
 
-		case WsVideoMode::Color2bpp: {
-			uint8_t tileData = _vram[tileAddr];
-			uint8_t tileData2 = _vram[tileAddr + 1];
-			return (
-				((tileData << column) & 0x80) >> 7 |
-				((tileData2 << column) & 0x80) >> 6
+		case WsVideoMode::Color4bpp:
+			tileData = (
+				_planarTileLut[_vram[tileAddr]] |
+				(_planarTileLut[_vram[tileAddr + 1]] << 1) |
+				(_planarTileLut[_vram[tileAddr + 2]] << 2) |
+				(_planarTileLut[_vram[tileAddr + 3]] << 3)
 			);
-		}
+			break;
 
-		case WsVideoMode::Color4bpp: {
-			uint8_t tileData = _vram[tileAddr];
-			uint8_t tileData2 = _vram[tileAddr + 1];
-			uint8_t tileData3 = _vram[tileAddr + 2];
-			uint8_t tileData4 = _vram[tileAddr + 3];
-			return (
-				((tileData << column) & 0x80) >> 7 |
-				((tileData2 << column) & 0x80) >> 6 |
-				((tileData3 << column) & 0x80) >> 5 |
-				((tileData4 << column) & 0x80) >> 4
-			);
+		case WsVideoMode::Color4bppPacked: {
+			//Each byte holds 2 pixels, with the leftmost pixel in the upper nibble
+			uint32_t data = _vram[tileAddr] | (_vram[tileAddr + 1] << 8) | (_vram[tileAddr + 2] << 16) | (_vram[tileAddr + 3] << 24);
+			tileData = ((data >> 4) & 0x0F0F0F0F) | ((data & 0x0F0F0F0F) << 4);
+			break;
 		}
-
-		case WsVideoMode::Color4bppPacked:
-			return (_vram[tileAddr + column / 2] >> (column & 0x01 ? 0 : 4)) & 0x0F;
 	}
 
-	return 0;
+	if(hMirror) {
+		//Reverse the order of the 8 nibbles
+		tileData = ((tileData >> 4) & 0x0F0F0F0F) | ((tileData & 0x0F0F0F0F) << 4);
+		tileData = ((tileData >> 8) & 0x00FF00FF) | ((tileData & 0x00FF00FF) << 8);
+		tileData = (tileData >> 16) | (tileData << 16);
+	}
+	return tileData;
 }
 
 void WsPpu::ProcessSpriteCopy()
@@ -478,7 +500,9 @@ uint8_t WsPpu::GetLcdStatus()
 
 void WsPpu::SendFrame()
 {
-	if(_state.SleepEnabled || !_state.LcdEnabled || _state.LastScanline == 255 || _console->IsPowerOff()) {
+	if(_skipRender) {
+		//Frame is skipped (fast forward), the previous frame is sent again
+	} else if(_state.SleepEnabled || !_state.LcdEnabled || _state.LastScanline == 255 || _console->IsPowerOff()) {
 		//Screen should be white when in sleep mode, or if the last scanline is set to 255
 		std::fill(_currentBuffer, _currentBuffer + WsConstants::MaxPixelCount, 0xFFF);
 	} else if(_state.LastScanline < 144) {
@@ -486,7 +510,7 @@ void WsPpu::SendFrame()
 		std::fill(_currentBuffer + _state.LastScanline * _screenWidth, _currentBuffer + WsConstants::MaxPixelCount, 0xFFF);
 	}
 
-	if(_showIcons) {
+	if(_showIcons && !_skipRender) {
 		DrawIcons();
 	}
 
@@ -503,6 +527,10 @@ void WsPpu::SendFrame()
 
 	_emu->ProcessEndOfFrame();
 	_console->ProcessEndOfFrame();
+
+	if(!_skipRender) {
+		_frameSkipTimer.Reset();
+	}
 }
 
 uint8_t WsPpu::ReadPort(uint16_t port)
@@ -3,6 +3,7 @@
 #include "WS/WsTypes.h"
 #include "Shared/Emulator.h"
 #include "Shared/SettingTypes.h"
+#include "Utilities/Timer.h"
 #include "Utilities/ISerializable.h"
 
 class Emulator;
@@ -33,10 +34,16 @@ private:
 
 	PixelData _rowData[2][224];
 
+	//Spreads the 8 bits of a planar tile byte to one nibble per pixel (leftmost pixel in the lowest nibble)
+	uint32_t _planarTileLut[256] = {};
+
 	uint16_t _screenHeight = 0;
 	uint16_t _screenWidth = 0;
 	bool _showIcons = false;
 
+	Timer _frameSkipTimer;
+	bool _skipRender = false;
+
 	void ProcessEndOfScanline();
 	void ProcessSpriteCopy();
 
@@ -50,7 +57,7 @@ private:
 	template<WsVideoMode mode> void DrawSprites();
 	template<WsVideoMode mode, int layerIndex> void DrawBackground();
 
-	template<WsVideoMode mode> __forceinline uint16_t GetPixelColor(uint16_t tileAddr, uint8_t column);
+	template<WsVideoMode mode> __forceinline uint32_t GetTileRow(uint16_t tileAddr, bool hMirror);
 
 	__forceinline uint16_t GetBgColor()
 	{
@@ -97,7 +104,7 @@ public:
 		}
 
 		if(_state.Cycle < 224) {
-			if(_state.Scanline < WsConstants::ScreenHeight + 1 && _state.Scanline > 0) {
+			if(_state.Scanline < WsConstants::ScreenHeight + 1 && _state.Scanline > 0 && !_skipRender) {
 				//Palette lookup + output pixel on the first 224 cycles
 				uint8_t rowIndex = (_state.Scanline & 0x01) ^ 1;
 				PixelData& data = _rowData[rowIndex][_state.Cycle];
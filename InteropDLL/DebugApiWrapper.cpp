@@ -4,6 +4,7 @@
 #include "Core/Debugger/Debugger.h"
 #include "Core/Debugger/IDebugger.h"
 #include "Core/Debugger/MemoryDumper.h"
+#include "Core/Debugger/MemorySearch.h"
 #include "Core/Debugger/MemoryAccessCounter.h"
 #include "Core/Debugger/CdlManager.h"
 #include "Core/Debugger/Disassembler.h"
@@ -77,7 +78,9 @@ extern "C"
 	DllExport uint32_t __stdcall GetDisassemblyOutput(CpuType type, uint32_t lineIndex, CodeLineData output[], uint32_t rowCount) { return WithDebugger(uint32_t, GetDisassembler()->GetDisassemblyOutput(type, lineIndex, output, rowCount)); }
 	DllExport uint32_t __stdcall GetDisassemblyRowAddress(CpuType type, uint32_t address, int32_t rowOffset) { return WithDebugger(uint32_t, GetDisassembler()->GetDisassemblyRowAddress(type, address, rowOffset)); }
 	DllExport int32_t __stdcall SearchDisassembly(CpuType type, const char* searchString, int32_t startPosition, DisassemblySearchOptions options) { return WithDebugger(int32_t, GetDisassemblySearch()->SearchDisassembly(type, searchString, startPosition, options)); }
-	DllExport uint32_t __stdcall FindOccurrences(CpuType type, const char* searchString, DisassemblySearchOptions options, CodeLineData results[], uint32_t maxResultCount) { return WithDebugger(uint32_t, GetDisassemblySearch()->FindOccurrences(type, searchString, options, results, maxResultCount)); }
+	DllExport void __stdcall StartFindOccurrences(CpuType type, const char* searchString, DisassemblySearchOptions options, uint32_t maxResultCount, uint32_t searchId) { WithDebugger(void, GetDisassemblySearch()->StartFindOccurrences(type, searchString, options, maxResultCount, searchId)); }
+	DllExport bool __stdcall GetFindOccurrencesResults(uint32_t searchId, uint32_t startIndex, CodeLineData results[], uint32_t maxResultCount, uint32_t& resultCount) { return WithDebugger(bool, GetDisassemblySearch()->GetFindOccurrencesResults(searchId, startIndex, results, maxResultCount, resultCount)); }
+	DllExport void __stdcall CancelDisassemblySearch(uint32_t searchId) { WithDebugger(void, GetDisassemblySearch()->CancelSearch(searchId)); }
 
 	DllExport void __stdcall SetTraceOptions(CpuType type, TraceLoggerOptions options) { WithToolVoid(GetTraceLogger(type), SetOptions(options)); }
 	DllExport uint32_t __stdcall GetExecutionTrace(TraceRow output[], uint32_t startOffset, uint32_t lineCount) { return WithDebugger(uint32_t, GetExecutionTrace(output, startOffset, lineCount)); }
@@ -108,6 +111,8 @@ extern "C"
 
 	DllExport void __stdcall ResetProfiler(CpuType cpuType) { WithToolVoid(GetCallstackManager(cpuType), GetProfiler()->Reset()); }
 
+	DllExport void __stdcall GetStepBackCheckpointStats(CpuType cpuType, CheckpointRingStats& stats) { WithDebugger(void, GetStepBackCheckpointStats(cpuType, stats)); }
+
 	DllExport void __stdcall GetConsoleState(BaseState& state, ConsoleType consoleType) { WithDebugger(void, GetConsoleState(state, consoleType)); }
 	DllExport void __stdcall GetCpuState(BaseState& state, CpuType cpuType) { WithDebugger(void, GetCpuState(state, cpuType)); }
 	DllExport void __stdcall GetPpuState(BaseState& state, CpuType cpuType) { WithDebugger(void, GetPpuState(state, cpuType)); }
@@ -162,6 +167,13 @@ extern "C"
 	DllExport bool __stdcall HasUndoHistory() { return WithDebugger(bool, GetMemoryDumper()->HasUndoHistory()); }
 	DllExport void __stdcall PerformUndo() { WithDebugger(void, GetMemoryDumper()->PerformUndo()); }
 
+	DllExport void __stdcall MemorySearchReset(MemoryType type) { WithDebugger(void, GetMemorySearch()->ResetSearch(type)); }
+	DllExport void __stdcall MemorySearchRefresh(MemoryType type) { WithDebugger(void, GetMemorySearch()->RefreshSnapshot(type)); }
+	DllExport uint32_t __stdcall MemorySearchAddFilter(MemoryType type, MemorySearchFilter filter) { return WithDebugger(uint32_t, GetMemorySearch()->AddFilter(type, filter)); }
+	DllExport bool __stdcall MemorySearchUndo(MemoryType type) { return WithDebugger(bool, GetMemorySearch()->Undo(type)); }
+	DllExport uint32_t __stdcall MemorySearchGetResultCount(MemoryType type) { return WithDebugger(uint32_t, GetMemorySearch()->GetResultCount(type)); }
+	DllExport uint32_t __stdcall MemorySearchGetResults(MemoryType type, uint32_t startIndex, uint8_t valueSize, bool bigEndian, MemorySearchResult results[], uint32_t maxResultCount) { return WithDebugger(uint32_t, GetMemorySearch()->GetResults(type, startIndex, valueSize, bigEndian, results, maxResultCount)); }
+
 	DllExport AddressInfo __stdcall GetAbsoluteAddress(AddressInfo relAddress) { return WithDebugger(AddressInfo, GetAbsoluteAddress(relAddress)); }
 	DllExport AddressInfo __stdcall GetRelativeAddress(AddressInfo absAddress, CpuType cpuType) { return WithDebugger(AddressInfo, GetRelativeAddress(absAddress, cpuType)); }
 
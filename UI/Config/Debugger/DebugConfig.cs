@@ -103,7 +103,9 @@ namespace Mesen.Config
 
 				ScriptAllowIoOsAccess = ScriptWindow.AllowIoOsAccess,
 				ScriptAllowNetworkAccess = ScriptWindow.AllowNetworkAccess,
-				ScriptTimeout = ScriptWindow.ScriptTimeout
+				ScriptTimeout = ScriptWindow.ScriptTimeout,
+
+				StepBackCheckpointInterval = Debugger.StepBackCheckpointInterval
 			});
 		}
 	}
@@ -176,6 +178,8 @@ namespace Mesen.Config
 		[MarshalAs(UnmanagedType.I1)] public bool ScriptAllowIoOsAccess;
 		[MarshalAs(UnmanagedType.I1)] public bool ScriptAllowNetworkAccess;
 		public UInt32 ScriptTimeout;
+
+		public UInt32 StepBackCheckpointInterval;
 	}
 
 	public enum RefreshSpeed
@@ -44,6 +44,8 @@ namespace Mesen.Config
 		[Reactive] public bool UsePredictiveBreakpoints { get; set; } = true;
 		[Reactive] public bool SingleBreakpointPerInstruction { get; set; } = true;
 
+		[Reactive] public UInt32 StepBackCheckpointInterval { get; set; } = 0;
+
 		[Reactive] public bool CopyAddresses { get; set; } = true;
 		[Reactive] public bool CopyByteCode { get; set; } = true;
 		[Reactive] public bool CopyComments { get; set; } = true;
@@ -937,10 +937,10 @@ namespace Mesen.Debugger.ViewModels
 			}
 
 			if(SourceView != null && GetActiveCodeTool() == DockFactory.SourceViewTool) {
+				FindResultList.CancelSearch();
 				FindResultList.SetResults(SourceView.FindAllOccurrences(search, options));
 			} else {
-				CodeLineData[] results = DebugApi.FindOccurrences(CpuType, search.Trim(), options);
-				FindResultList.SetResults(results.Select(x => new FindResultViewModel(x)));
+				FindResultList.StartSearch(search.Trim(), options);
 			}
 		}
 
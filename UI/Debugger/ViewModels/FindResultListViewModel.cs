@@ -36,6 +36,10 @@ public class FindResultListViewModel : DisposableViewModel
 	private CodeLineData[] _results = Array.Empty<CodeLineData>();
 	private string _format;
 
+	private UInt32 _searchId = 0;
+	private DispatcherTimer? _searchTimer = null;
+	private List<FindResultViewModel> _searchResults = new();
+
 	[Obsolete("For designer only")]
 	public FindResultListViewModel() : this(new()) { }
 
@@ -52,6 +56,56 @@ public class FindResultListViewModel : DisposableViewModel
 		UpdateResults(FindResults);
 	}
 
+	public void StartSearch(string search, DisassemblySearchOptions options)
+	{
+		//Results are displayed as they are found, the previous search is cancelled if it's still running
+		CancelSearch();
+		_searchId = DebugApi.StartFindOccurrences(Debugger.CpuType, search, options);
+		_searchResults = new();
+		SetResults(_searchResults);
+		if(UpdateSearchResults()) {
+			_searchTimer = new DispatcherTimer(TimeSpan.FromMilliseconds(50), DispatcherPriority.Normal, (s, e) => {
+				if(!UpdateSearchResults()) {
+					CancelSearch();
+				}
+			});
+		}
+	}
+
+	private bool UpdateSearchResults()
+	{
+		bool isRunning;
+		int prevCount = _searchResults.Count;
+		CodeLineData[] results;
+		do {
+			results = DebugApi.GetFindOccurrencesResults(_searchId, (UInt32)_searchResults.Count, out isRunning);
+			_searchResults.AddRange(results.Select(x => new FindResultViewModel(x)));
+		} while(results.Length > 0);
+
+		if(_searchResults.Count > prevCount) {
+			UpdateResults(_searchResults);
+			if(prevCount == 0) {
+				Selection.SelectedIndex = 0;
+			}
+		}
+		return isRunning;
+	}
+
+	public void CancelSearch()
+	{
+		_searchTimer?.Stop();
+		_searchTimer = null;
+		if(_searchId != 0) {
+			DebugApi.CancelDisassemblySearch(_searchId);
+			_searchId = 0;
+		}
+	}
+
+	protected override void DisposeView()
+	{
+		CancelSearch();
+	}
+
 	public void SetResults(IEnumerable<FindResultViewModel> results)
 	{
 		Selection.Clear();
@@ -52,22 +52,17 @@ public class MemorySearchViewModel : DisposableViewModel
 	[Reactive] public bool IsUndoEnabled { get; set; } = false;
 	[Reactive] public bool IsSpecificValueEnabled { get; set; } = false;
 	[Reactive] public bool IsSpecificAddressEnabled { get; set; } = false;
-	
-	public int[] AddressLookup => _addressLookup;
-	public byte[] MemoryState => _memoryState;
-	public byte[] PrevMemoryState => _prevMemoryState;
 
-	private List<MemoryAddressViewModel> _innerData = new();
+	//Results are fetched from the core one page at a time, only for the rows that are displayed
+	private const int ResultPageSize = 256;
 
-	private int[] _addressLookup = Array.Empty<int>();
-	
-	private byte[] _lastSearchSnapshot = Array.Empty<byte>();
-	private HashSet<int> _hiddenAddresses = new();	
-	
-	private List<SearchHistory> _undoHistory = new();
+	private List<MemoryAddressViewModel> _innerData = new();
 
-	private byte[] _memoryState = Array.Empty<byte>();
-	private byte[] _prevMemoryState = Array.Empty<byte>();
+	//Set when the list is sorted on something other than the address (requires all results to be fetched)
+	private MemorySearchResult[]? _sortedResults = null;
+	private Dictionary<int, MemorySearchResult[]> _resultPages = new();
+	private long _specificAddressValue = 0;
+	private int _undoCount = 0;
 
 	private bool _isRefreshing;
 
@@ -129,8 +124,8 @@ public class MemorySearchViewModel : DisposableViewModel
 
 	public void RefreshData(bool forceSort)
 	{
-		_prevMemoryState = _memoryState;
-		_memoryState = DebugApi.GetMemoryState(MemoryType);
+		//The core keeps the memory state of the last 2 refreshes, only the displayed rows are sent to the UI
+		DebugApi.MemorySearchRefresh(MemoryType);
 
 		Dispatcher.UIThread.Post(() => {
 			RefreshList(forceSort);
@@ -139,48 +134,51 @@ public class MemorySearchViewModel : DisposableViewModel
 
 	private void RefreshList(bool forceSort)
 	{
-		byte[] memoryState = _memoryState;
-		byte[] prevMemoryState = _prevMemoryState;
-
-		if(memoryState.Length != prevMemoryState.Length) {
-			//Mismatching arrays - happens when changing game or mem type
-			return;
-		}
-
 		if(_isRefreshing) {
 			return;
 		}
 
 		_isRefreshing = true;
 		List<Tuple<string, ListSortDirection>> sortOrder = new(SortState.SortOrder);
+		MemoryType memType = MemoryType;
+		MemorySearchValueSize valueSize = ValueSize;
+		int specificAddress = SpecificAddress;
 
 		Task.Run(() => {
+			int resultCount = (int)DebugApi.MemorySearchGetResultCount(memType);
+			long specificAddressValue = GetSpecificAddressValue(memType, specificAddress, valueSize);
+
+			//Results are returned in address order, only fetch all of them when they need to be sorted differently
+			MemorySearchResult[]? sortedResults = null;
 			bool isDefaultSort = sortOrder.Count == 1 && sortOrder[0].Item2 == ListSortDirection.Ascending && sortOrder[0].Item1 == "Address";
-			if(!isDefaultSort || forceSort) {
-				Sort(sortOrder);
+			if(!isDefaultSort) {
+				sortedResults = DebugApi.MemorySearchGetResults(memType, 0, (byte)valueSize, false, (uint)resultCount);
+				Sort(memType, sortedResults, sortOrder);
+				resultCount = sortedResults.Length;
 			}
 
-			Dispatcher.UIThread.Post(() => RefreshUiList(memoryState));
+			Dispatcher.UIThread.Post(() => RefreshUiList(resultCount, sortedResults, specificAddressValue));
 		});
 	}
 
-	private void RefreshUiList(byte[] memoryState)
+	private void RefreshUiList(int resultCount, MemorySearchResult[]? sortedResults, long specificAddressValue)
 	{
 		if(Disposed) {
 			return;
 		}
 
-		MemoryType memType = MemoryType;
+		_sortedResults = sortedResults;
+		_resultPages.Clear();
+		_specificAddressValue = specificAddressValue;
 
-		if(_innerData.Count < memoryState.Length) {
-			_innerData.AddRange(Enumerable.Range(_innerData.Count, memoryState.Length - _innerData.Count).Select(i => new MemoryAddressViewModel(i, this)));
-		} else if(_innerData.Count > memoryState.Length) {
-			_innerData.RemoveRange(memoryState.Length, _innerData.Count - memoryState.Length);
+		if(_innerData.Count < resultCount) {
+			_innerData.AddRange(Enumerable.Range(_innerData.Count, resultCount - _innerData.Count).Select(i => new MemoryAddressViewModel(i, this)));
+		} else if(_innerData.Count > resultCount) {
+			_innerData.RemoveRange(resultCount, _innerData.Count - resultCount);
 		}
 
-		int visibleCount = memoryState.Length - _hiddenAddresses.Count;
-		if(ListData.Count != visibleCount) {
-			ListData.Replace(_innerData.GetRange(0, visibleCount));
+		if(ListData.Count != resultCount) {
+			ListData.Replace(_innerData.GetRange(0, resultCount));
 		}
 
 		List<MemoryAddressViewModel> list = ListData.GetInnerList();
@@ -191,42 +189,74 @@ public class MemorySearchViewModel : DisposableViewModel
 		_isRefreshing = false;
 	}
 
-	public void Sort(List<Tuple<string, ListSortDirection>> sortOrder)
+	public bool TryGetResult(int index, out MemorySearchResult result)
+	{
+		result = default;
+		if(_sortedResults != null) {
+			if(index >= _sortedResults.Length) {
+				return false;
+			}
+			result = _sortedResults[index];
+			return true;
+		}
+
+		int page = index / ResultPageSize;
+		if(!_resultPages.TryGetValue(page, out MemorySearchResult[]? results)) {
+			results = DebugApi.MemorySearchGetResults(MemoryType, (uint)(page * ResultPageSize), (byte)ValueSize, false, ResultPageSize);
+			_resultPages[page] = results;
+		}
+
+		int offset = index % ResultPageSize;
+		if(offset >= results.Length) {
+			return false;
+		}
+		result = results[offset];
+		return true;
+	}
+
+	private long GetSpecificAddressValue(MemoryType memType, int address, MemorySearchValueSize valueSize)
 	{
-		byte[] mem = _memoryState;
-		byte[] prevMem = _prevMemoryState;
+		int memSize = DebugApi.GetMemorySize(memType);
+		if(address >= memSize) {
+			return 0;
+		}
+
+		byte[] bytes = DebugApi.GetMemoryValues(memType, (uint)address, (uint)Math.Min(memSize - 1, address + (int)valueSize - 1));
+		uint value = 0;
+		for(int i = 0; i < bytes.Length; i++) {
+			value |= (uint)bytes[i] << (i * 8);
+		}
+		return GetValue(value);
+	}
 
+	private void Sort(MemoryType memType, MemorySearchResult[] results, List<Tuple<string, ListSortDirection>> sortOrder)
+	{
 		AddressCounters[] counters = Array.Empty<AddressCounters>();
-		foreach((string column, ListSortDirection order) in SortState.SortOrder) {
+		foreach((string column, ListSortDirection order) in sortOrder) {
 			if(column.Contains("Read") || column.Contains("Write") || column.Contains("Exec")) {
 				//Only get counters if user sorted on a counter column
-				counters = DebugApi.GetMemoryAccessCounts(MemoryType);
+				counters = DebugApi.GetMemoryAccessCounts(memType);
 				break;
 			}
 		}
 
-		Dictionary<string, Func<int, int, int>> comparers = new() {
-			{ "Address", (a, b) => a.CompareTo(b) },
-			{ "Value", (a, b) => GetValue(a, mem).CompareTo(GetValue(b, mem)) },
-			{ "PrevValue", (a, b) => GetValue(a, prevMem).CompareTo(GetValue(b, prevMem)) },
-			{ "ReadCount", (a, b) => counters[a].ReadCounter.CompareTo(counters[b].ReadCounter) },
-			{ "LastRead", (a, b) => -counters[a].ReadStamp.CompareTo(counters[b].ReadStamp) },
-			{ "WriteCount", (a, b) => counters[a].WriteCounter.CompareTo(counters[b].WriteCounter) },
-			{ "LastWrite", (a, b) => -counters[a].WriteStamp.CompareTo(counters[b].WriteStamp) },
-			{ "ExecCount", (a, b) => counters[a].ExecCounter.CompareTo(counters[b].ExecCounter) },
-			{ "LastExec", (a, b) => -counters[a].ExecStamp.CompareTo(counters[b].ExecStamp) },
+		Dictionary<string, Func<MemorySearchResult, MemorySearchResult, int>> comparers = new() {
+			{ "Address", (a, b) => a.Address.CompareTo(b.Address) },
+			{ "Value", (a, b) => GetValue(a.Value).CompareTo(GetValue(b.Value)) },
+			{ "PrevValue", (a, b) => GetValue(a.PrevRefreshValue).CompareTo(GetValue(b.PrevRefreshValue)) },
+			{ "ReadCount", (a, b) => counters[a.Address].ReadCounter.CompareTo(counters[b.Address].ReadCounter) },
+			{ "LastRead", (a, b) => -counters[a.Address].ReadStamp.CompareTo(counters[b.Address].ReadStamp) },
+			{ "WriteCount", (a, b) => counters[a.Address].WriteCounter.CompareTo(counters[b.Address].WriteCounter) },
+			{ "LastWrite", (a, b) => -counters[a.Address].WriteStamp.CompareTo(counters[b.Address].WriteStamp) },
+			{ "ExecCount", (a, b) => counters[a.Address].ExecCounter.CompareTo(counters[b.Address].ExecCounter) },
+			{ "LastExec", (a, b) => -counters[a.Address].ExecStamp.CompareTo(counters[b.Address].ExecStamp) },
 		};
 
-		SortHelper.SortArray(_addressLookup, sortOrder, comparers, "Address");
+		SortHelper.SortArray(results, sortOrder, comparers, "Address");
 	}
 
-	public long GetValue(int address, byte[] memoryState)
+	public long GetValue(uint value)
 	{
-		uint value = 0;
-		for(int i = 0; i < (int)ValueSize && address + i < memoryState.Length; i++) {
-			value |= (uint)memoryState[address + i] << (i * 8);
-		}
-
 		switch(Format) {
 			default:
 			case MemorySearchFormat.Hex: {
@@ -251,14 +281,14 @@ public class MemorySearchViewModel : DisposableViewModel
 		}
 	}
 
-	public bool IsMatch(int address)
+	public bool IsMatch(MemorySearchResult result)
 	{
-		long value = GetValue(address, _memoryState);
+		long value = GetValue(result.Value);
 		
 		long compareValue = CompareTo switch {
-			MemorySearchCompareTo.PreviousSearchValue => GetValue(address, _lastSearchSnapshot),
-			MemorySearchCompareTo.PreviousRefreshValue => GetValue(address, _prevMemoryState),
-			MemorySearchCompareTo.SpecificAddress => GetValue(SpecificAddress, _memoryState),
+			MemorySearchCompareTo.PreviousSearchValue => GetValue(result.PrevSearchValue),
+			MemorySearchCompareTo.PreviousRefreshValue => GetValue(result.PrevRefreshValue),
+			MemorySearchCompareTo.SpecificAddress => _specificAddressValue,
 			MemorySearchCompareTo.SpecificValue => SpecificValue,
 			_ => throw new Exception("Unsupported compare type")
 		};
@@ -276,61 +306,36 @@ public class MemorySearchViewModel : DisposableViewModel
 
 	public void AddFilter()
 	{
-		_undoHistory.Add(new SearchHistory(_hiddenAddresses, _lastSearchSnapshot));
-		IsUndoEnabled = true;
-
-		int count = _lastSearchSnapshot.Length;
-		for(int i = 0; i < count; i++) {
-			if(_hiddenAddresses.Contains(i)) {
-				continue;
-			} else if(!IsMatch(i)) {
-				_hiddenAddresses.Add(i);
-			}
-		}
-
-		UpdateAddressLookup();
+		DebugApi.MemorySearchAddFilter(MemoryType, new InteropMemorySearchFilter() {
+			CompareTo = CompareTo,
+			Operator = Operator,
+			ValueSize = (byte)ValueSize,
+			IsSigned = Format == MemorySearchFormat.Signed,
+			BigEndian = false,
+			SpecificValue = (uint)SpecificValue,
+			SpecificAddress = (uint)SpecificAddress
+		});
 
-		_lastSearchSnapshot = DebugApi.GetMemoryState(MemoryType);
+		_undoCount++;
+		IsUndoEnabled = true;
 		RefreshList(true);
 	}
 
-	private void UpdateAddressLookup()
-	{
-		int count = _lastSearchSnapshot.Length;
-		int[] addressLookup = new int[count];
-		int visibleRowCounter = 0;
-
-		for(int i = 0; i < count; i++) {
-			if(!_hiddenAddresses.Contains(i)) {
-				addressLookup[visibleRowCounter] = i;
-				visibleRowCounter++;
-			}
-		}
-
-		Array.Resize(ref addressLookup, visibleRowCounter);
-		_addressLookup = addressLookup;
-	}
-
 	public void ResetSearch()
 	{
-		_lastSearchSnapshot = DebugApi.GetMemoryState(MemoryType);
-		_addressLookup = Enumerable.Range(0, _lastSearchSnapshot.Length).ToArray();
-		MaxAddress = Math.Max(0, _lastSearchSnapshot.Length - 1);
-		_hiddenAddresses.Clear();
-		_undoHistory.Clear();
+		DebugApi.MemorySearchReset(MemoryType);
+		MaxAddress = Math.Max(0, DebugApi.GetMemorySize(MemoryType) - 1);
+		_undoCount = 0;
 		IsUndoEnabled = false;
-		_memoryState = DebugApi.GetMemoryState(MemoryType);
-		RefreshData(true);
+		RefreshList(true);
 	}
 
 	public void Undo()
 	{
-		if(_undoHistory.Count > 0) {
-			_hiddenAddresses = _undoHistory[^1].HiddenAddresses;
-			_lastSearchSnapshot = _undoHistory[^1].SearchSnapshot;
-			_undoHistory.RemoveAt(_undoHistory.Count - 1);
-			IsUndoEnabled = _undoHistory.Count > 0;
-			UpdateAddressLookup();
+		if(_undoCount > 0) {
+			//The core may have discarded the oldest entries (when the memory type is large)
+			_undoCount = DebugApi.MemorySearchUndo(MemoryType) ? _undoCount - 1 : 0;
+			IsUndoEnabled = _undoCount > 0;
 			RefreshList(true);
 		}
 	}
@@ -340,18 +345,6 @@ public class MemorySearchViewModel : DisposableViewModel
 		DebugApi.ResetMemoryAccessCounts();
 		RefreshList(true);
 	}
-
-	private class SearchHistory
-	{
-		public HashSet<int> HiddenAddresses;
-		public byte[] SearchSnapshot;
-
-		public SearchHistory(HashSet<int> hiddenAddresses, byte[] searchSnapshot)
-		{
-			HiddenAddresses = new(hiddenAddresses);
-			SearchSnapshot = searchSnapshot;
-		}
-	}
 }
 
 public class MemoryAddressViewModel : INotifyPropertyChanged
@@ -422,19 +415,15 @@ public class MemoryAddressViewModel : INotifyPropertyChanged
 
 	private void UpdateFields()
 	{
-		if(_index >= _search.AddressLookup.Length) {
+		if(!_search.TryGetResult(_index, out MemorySearchResult result)) {
 			return;
 		}
 
-		int address = _search.AddressLookup[_index];
+		int address = (int)result.Address;
 		_addressString = address.ToString("X4");
 
-		uint value = 0;
-		uint prevValue = 0;
-		for(int i = 0; i < (int)_search.ValueSize && address + i < _search.MemoryState.Length; i++) {
-			value |= (uint)_search.MemoryState[address + i] << (i * 8);
-			prevValue |= (uint)_search.PrevMemoryState[address + i] << (i * 8);
-		}
+		uint value = result.Value;
+		uint prevValue = result.PrevRefreshValue;
 
 		switch(_search.Format) {
 			case MemorySearchFormat.Hex: {
@@ -492,7 +481,7 @@ public class MemoryAddressViewModel : INotifyPropertyChanged
 		LastWrite = CodeTooltipHelper.FormatCount(masterClock - counters.WriteStamp, counters.WriteStamp);
 		LastExec = CodeTooltipHelper.FormatCount(masterClock - counters.ExecStamp, counters.ExecStamp);
 
-		IsMatch = _search.IsMatch(address);
+		IsMatch = _search.IsMatch(result);
 	}
 }
 
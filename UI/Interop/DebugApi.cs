@@ -7,6 +7,7 @@ using System.IO.Compression;
 using System.Linq;
 using System.Runtime.InteropServices;
 using System.Text;
+using System.Threading;
 using System.Threading.Tasks;
 using Avalonia;
 using Mesen.Config;
@@ -78,10 +79,24 @@ namespace Mesen.Interop
 		[DllImport(DllPath)] public static extern int GetDisassemblyRowAddress(CpuType type, UInt32 address, int rowOffset);
 		[DllImport(DllPath)] public static extern int SearchDisassembly(CpuType type, [MarshalAs(UnmanagedType.LPUTF8Str)] string searchString, int startAddress, DisassemblySearchOptions options);
 		
-		[DllImport(DllPath)] private static extern UInt32 FindOccurrences(CpuType type, [MarshalAs(UnmanagedType.LPUTF8Str)] string searchString, DisassemblySearchOptions options, [In, Out] InteropCodeLineData[] lineData, UInt32 maxResultCount);
-		public static CodeLineData[] FindOccurrences(CpuType type, string searchString, DisassemblySearchOptions options)
+		private static UInt32 _lastSearchId = 0;
+		[DllImport(DllPath)] public static extern void CancelDisassemblySearch(UInt32 searchId);
+
+		[DllImport(DllPath)] private static extern void StartFindOccurrences(CpuType type, [MarshalAs(UnmanagedType.LPUTF8Str)] string searchString, DisassemblySearchOptions options, UInt32 maxResultCount, UInt32 searchId);
+		public static UInt32 StartFindOccurrences(CpuType type, string searchString, DisassemblySearchOptions options)
+		{
+			//The search runs in the background, its results are fetched with GetFindOccurrencesResults
+			UInt32 searchId = Interlocked.Increment(ref _lastSearchId);
+			DebugApi.StartFindOccurrences(type, searchString, options, 500, searchId);
+			return searchId;
+		}
+
+		[DllImport(DllPath, EntryPoint = "GetFindOccurrencesResults")]
+		[return: MarshalAs(UnmanagedType.I1)]
+		private static extern bool GetFindOccurrencesResultsWrapper(UInt32 searchId, UInt32 startIndex, [In, Out] InteropCodeLineData[] lineData, UInt32 maxResultCount, ref UInt32 resultCount);
+		public static CodeLineData[] GetFindOccurrencesResults(UInt32 searchId, UInt32 startIndex, out bool isRunning)
 		{
-			UInt32 maxResultCount = 500;
+			UInt32 maxResultCount = 100;
 			InteropCodeLineData[] rows = new InteropCodeLineData[maxResultCount];
 			for(int i = 0; i < maxResultCount; i++) {
 				rows[i].Comment = new byte[1000];
@@ -89,7 +104,8 @@ namespace Mesen.Interop
 				rows[i].ByteCode = new byte[8];
 			}
 
-			UInt32 resultCount = DebugApi.FindOccurrences(type, searchString, options, rows, maxResultCount);
+			UInt32 resultCount = 0;
+			isRunning = DebugApi.GetFindOccurrencesResultsWrapper(searchId, startIndex, rows, maxResultCount, ref resultCount);
 
 			CodeLineData[] result = new CodeLineData[resultCount];
 			for(int i = 0; i < resultCount; i++) {
@@ -238,6 +254,20 @@ namespace Mesen.Interop
 		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool HasUndoHistory();
 		[DllImport(DllPath)] public static extern void PerformUndo();
 
+		[DllImport(DllPath)] public static extern void MemorySearchReset(MemoryType type);
+		[DllImport(DllPath)] public static extern void MemorySearchRefresh(MemoryType type);
+		[DllImport(DllPath)] public static extern UInt32 MemorySearchAddFilter(MemoryType type, InteropMemorySearchFilter filter);
+		[DllImport(DllPath)][return: MarshalAs(UnmanagedType.I1)] public static extern bool MemorySearchUndo(MemoryType type);
+		[DllImport(DllPath)] public static extern UInt32 MemorySearchGetResultCount(MemoryType type);
+		[DllImport(DllPath, EntryPoint = "MemorySearchGetResults")] private static extern UInt32 MemorySearchGetResultsWrapper(MemoryType type, UInt32 startIndex, byte valueSize, [MarshalAs(UnmanagedType.I1)] bool bigEndian, [In, Out] MemorySearchResult[] results, UInt32 maxResultCount);
+		public static MemorySearchResult[] MemorySearchGetResults(MemoryType type, UInt32 startIndex, byte valueSize, bool bigEndian, UInt32 maxResultCount)
+		{
+			MemorySearchResult[] results = new MemorySearchResult[maxResultCount];
+			UInt32 count = DebugApi.MemorySearchGetResultsWrapper(type, startIndex, valueSize, bigEndian, results, maxResultCount);
+			Array.Resize(ref results, (int)count);
+			return results;
+		}
+
 		[DllImport(DllPath)] public static extern void UpdateFrozenAddresses(CpuType cpuType, UInt32 start, UInt32 end, [MarshalAs(UnmanagedType.I1)] bool freeze);
 		[DllImport(DllPath)] private static extern void GetFrozenState(CpuType type, UInt32 start, UInt32 end, [In, Out] byte[] outState);
 		public static byte[] GetFrozenState(CpuType cpuType, UInt32 start, UInt32 end)
@@ -479,6 +509,8 @@ namespace Mesen.Interop
 			return (int)functionCount;
 		}
 
+		[DllImport(DllPath)] public static extern void GetStepBackCheckpointStats(CpuType type, out CheckpointRingStats stats);
+
 		[DllImport(DllPath, EntryPoint = "GetTokenList")] private static extern void GetTokenListWrapper(CpuType cpuType, IntPtr tokenListBuffer);
 		public static unsafe string[] GetTokenList(CpuType type)
 		{
@@ -1676,6 +1708,33 @@ namespace Mesen.Interop
 		public UInt32 TotalChrBytes;
 	}
 
+	public struct InteropMemorySearchFilter
+	{
+		public Mesen.Debugger.ViewModels.MemorySearchCompareTo CompareTo;
+		public Mesen.Debugger.ViewModels.MemorySearchOperator Operator;
+		public byte ValueSize;
+		[MarshalAs(UnmanagedType.I1)] public bool IsSigned;
+		[MarshalAs(UnmanagedType.I1)] public bool BigEndian;
+		public UInt32 SpecificValue;
+		public UInt32 SpecificAddress;
+	}
+
+	public struct MemorySearchResult
+	{
+		public UInt32 Address;
+		public UInt32 Value;
+		public UInt32 PrevRefreshValue;
+		public UInt32 PrevSearchValue;
+	}
+
+	public struct CheckpointRingStats
+	{
+		public UInt32 MemoryUsage;
+		public UInt32 CheckpointCount;
+		public UInt64 OldestClock;
+		public UInt64 NewestClock;
+	}
+
 	public struct ProfiledFunction
 	{
 		public UInt64 ExclusiveCycles;
@@ -0,0 +1,25 @@
+#pragma once
+#include "pch.h"
+
+//SSE2 is part of the x64 baseline, so it is always available on 64-bit x86 builds
+#if defined(__SSE2__) || defined(_M_X64) || defined(_M_AMD64)
+	#include <emmintrin.h>
+	#define MESEN_SSE2
+#endif
+
+#ifdef MESEN_SSE2
+class SimdUtilities
+{
+public:
+	//Runs op(channelA, channelB) on each 5-bit channel of 8 RGB555 pixels and packs the results (0-31) back into RGB555 pixels
+	template<typename T>
+	__forceinline static __m128i BlendRgb555(__m128i a, __m128i b, T op)
+	{
+		__m128i mask = _mm_set1_epi16(0x1F);
+		__m128i red = op(_mm_and_si128(a, mask), _mm_and_si128(b, mask));
+		__m128i green = op(_mm_and_si128(_mm_srli_epi16(a, 5), mask), _mm_and_si128(_mm_srli_epi16(b, 5), mask));
+		__m128i blue = op(_mm_and_si128(_mm_srli_epi16(a, 10), mask), _mm_and_si128(_mm_srli_epi16(b, 10), mask));
+		return _mm_or_si128(_mm_or_si128(red, _mm_slli_epi16(green, 5)), _mm_slli_epi16(blue, 10));
+	}
+};
+#endif